@@ -937,6 +937,9 @@ extern "C" {
 #define GLFW_COCOA_RETINA_FRAMEBUFFER 0x00023001
 #define GLFW_COCOA_FRAME_AUTOSAVE     0x00023002
 #define GLFW_COCOA_GRAPHICS_SWITCHING 0x00023003
+
+#define GLFW_OSMESA_COLOR_FORMAT    0x00024001
+#define GLFW_OSMESA_BUFFER_COUNT    0x00024002
 /*! @} */
 
 #define GLFW_NO_API                          0
@@ -954,6 +957,7 @@ extern "C" {
 #define GLFW_CURSOR                 0x00033001
 #define GLFW_STICKY_KEYS            0x00033002
 #define GLFW_STICKY_MOUSE_BUTTONS   0x00033003
+#define GLFW_RAW_MOUSE_MOTION       0x00033004
 
 #define GLFW_CURSOR_NORMAL          0x00034001
 #define GLFW_CURSOR_HIDDEN          0x00034002
@@ -967,6 +971,16 @@ extern "C" {
 #define GLFW_EGL_CONTEXT_API        0x00036002
 #define GLFW_OSMESA_CONTEXT_API     0x00036003
 
+#define GLFW_OSMESA_RGBA            0x00037001
+#define GLFW_OSMESA_BGRA            0x00037002
+#define GLFW_OSMESA_RGB_565         0x00037003
+
+#define GLFW_FRAME_SINK_RAW         0x00038001
+#define GLFW_FRAME_SINK_PPM         0x00038002
+#define GLFW_FRAME_SINK_PNG         0x00038003
+#define GLFW_FRAME_SINK_DROP        0x00038004
+#define GLFW_FRAME_SINK_BLOCK       0x00038005
+
 /*! @defgroup shapes Standard cursor shapes
  *  @brief Standard system cursor shapes.
  *
@@ -1016,6 +1030,14 @@ extern "C" {
 
 #define GLFW_COCOA_CHDIR_RESOURCES  0x00051001
 #define GLFW_COCOA_MENUBAR          0x00051002
+
+#define GLFW_OSMESA_BUFFER_POOL_LIMIT 0x00052001
+#define GLFW_OSMESA_HUGE_PAGES      0x00052002
+
+#define GLFW_NULL_MONITOR_COUNT     0x00053001
+#define GLFW_NULL_GAMMA_RAMP_SIZE   0x00053002
+
+#define GLFW_X11_CLIPBOARD_TIMEOUT  0x00054001
 /*! @} */
 
 #define GLFW_DONT_CARE              -1
@@ -1378,6 +1400,25 @@ typedef void (* GLFWcharfun)(GLFWwindow*,unsigned int);
  */
 typedef void (* GLFWcharmodsfun)(GLFWwindow*,unsigned int,int);
 
+/*! @brief The function signature for text input callbacks.
+ *
+ *  This is the function signature for text input callback functions.  It is
+ *  called with each run of text committed by the text input system.
+ *
+ *  @param[in] window The window that received the event.
+ *  @param[in] text The UTF-8 encoded text, without any control characters.
+ *
+ *  @pointer_lifetime The text is valid until the callback function returns.
+ *
+ *  @sa @ref input_char
+ *  @sa @ref glfwSetTextCallback
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWtextfun)(GLFWwindow*,const char*);
+
 /*! @brief The function signature for file drop callbacks.
  *
  *  This is the function signature for file drop callbacks.
@@ -1395,6 +1436,49 @@ typedef void (* GLFWcharmodsfun)(GLFWwindow*,unsigned int,int);
  */
 typedef void (* GLFWdropfun)(GLFWwindow*,int,const char**);
 
+/*! @brief The function signature for clipboard request callbacks.
+ *
+ *  This is the function signature for clipboard request callback functions.
+ *
+ *  @param[in] window The window that requested the clipboard contents.
+ *  @param[in] string The contents of the clipboard as a UTF-8 encoded string,
+ *  or `NULL` if the clipboard is empty or could not be converted.
+ *
+ *  @pointer_lifetime The string is valid until the callback function returns.
+ *
+ *  @sa @ref clipboard
+ *  @sa @ref glfwRequestClipboardString
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWclipboardfun)(GLFWwindow*,const char*);
+
+/*! @brief The function signature for clipboard data provider callbacks.
+ *
+ *  This is the function signature for clipboard data provider callback
+ *  functions.
+ *
+ *  @param[in] window The window that set the clipboard provider.
+ *  @param[in] type The type of the requested data.
+ *  @param[out] size Where to store the size, in bytes, of the data.
+ *  @return The data of the requested type, or `NULL` if it cannot be
+ *  provided.
+ *
+ *  @pointer_lifetime The returned data is copied before the callback function
+ *  is called again or returns control to the application, so it need only
+ *  remain valid until then.
+ *
+ *  @sa @ref clipboard_data
+ *  @sa @ref glfwSetClipboardProvider
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+typedef const void* (* GLFWclipboardproviderfun)(GLFWwindow*,const char*,size_t*);
+
 /*! @brief The function signature for monitor configuration callbacks.
  *
  *  This is the function signature for monitor configuration callback functions.
@@ -1536,6 +1620,51 @@ typedef struct GLFWgamepadstate
     float axes[6];
 } GLFWgamepadstate;
 
+/*! @brief Raw mouse motion sample.
+ *
+ *  This describes a single relative motion event from a mouse, without any
+ *  scaling or acceleration applied by the window system.
+ *
+ *  @sa @ref raw_mouse_motion
+ *  @sa @ref glfwSetRawMotionCallback
+ *
+ *  @since Added in version 3.3.
+ */
+typedef struct GLFWrawmotion
+{
+    /*! The motion along the x-axis, in device units.
+     */
+    double dx;
+    /*! The motion along the y-axis, in device units.
+     */
+    double dy;
+    /*! The time of the event, in seconds, as reported by the window system.
+     *  This uses a different clock than @ref glfwGetTime.
+     */
+    double time;
+} GLFWrawmotion;
+
+/*! @brief The function signature for raw mouse motion callbacks.
+ *
+ *  This is the function signature for raw mouse motion callback functions.
+ *
+ *  @param[in] window The window that received the events.
+ *  @param[in] samples The raw motion samples received since the previous call,
+ *  in the order they were received.
+ *  @param[in] count The number of samples in the array.
+ *
+ *  @pointer_lifetime The sample array is valid until the callback function
+ *  returns.
+ *
+ *  @sa @ref raw_mouse_motion
+ *  @sa @ref glfwSetRawMotionCallback
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWrawmotionfun)(GLFWwindow*,const GLFWrawmotion*,int);
+
 
 /*************************************************************************
  * GLFW API functions
@@ -1729,6 +1858,33 @@ GLFWAPI const char* glfwGetVersionString(void);
  */
 GLFWAPI int glfwGetError(const char** description);
 
+/*! @brief Returns the number of errors that occurred on the calling thread.
+ *
+ *  This function returns the total number of errors that have occurred on the
+ *  calling thread.  Unlike @ref glfwGetError it does not clear anything, so it
+ *  can be sampled periodically to measure the error rate of code that is
+ *  expected to fail often, for example capability probing.
+ *
+ *  @return The number of errors that have occurred on the calling thread.
+ *
+ *  @errors None.
+ *
+ *  @remark This function may be called before @ref glfwInit.
+ *
+ *  @remark The counts of threads other than the one that initialized the
+ *  library are discarded when it is terminated.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref error_handling
+ *  @sa @ref glfwGetError
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup init
+ */
+GLFWAPI uint64_t glfwGetErrorCount(void);
+
 /*! @brief Sets the error callback.
  *
  *  This function sets the error callback, which is called with an error code
@@ -1992,9 +2148,10 @@ GLFWAPI const GLFWvidmode* glfwGetVideoMode(GLFWmonitor* monitor);
 
 /*! @brief Generates a gamma ramp and sets it for the specified monitor.
  *
- *  This function generates a 256-element gamma ramp from the specified exponent
- *  and then calls @ref glfwSetGammaRamp with it.  The value must be a finite
- *  number greater than zero.
+ *  This function generates a gamma ramp from the specified exponent and then
+ *  sets it like @ref glfwSetGammaRamp.  The ramp has the size used by the
+ *  monitor, or 256 elements if the size is not known.  The value must be
+ *  a finite number greater than zero.
  *
  *  The software controlled gamma ramp is applied _in addition_ to the hardware
  *  gamma correction, which today is usually an approximation of sRGB gamma.
@@ -2023,6 +2180,46 @@ GLFWAPI const GLFWvidmode* glfwGetVideoMode(GLFWmonitor* monitor);
  */
 GLFWAPI void glfwSetGamma(GLFWmonitor* monitor, float gamma);
 
+/*! @brief Generates an adjusted gamma ramp and sets it for the specified
+ *  monitor.
+ *
+ *  This function generates a gamma ramp from the specified per-channel
+ *  exponents, brightness and color temperature and then sets it like @ref
+ *  glfwSetGammaRamp.  The ramp has the size used by the monitor, or 256
+ *  elements if the size is not known.
+ *
+ *  The curves and ramp generated for a monitor are kept until the parameters
+ *  change, so fading only the brightness or temperature does not calculate the
+ *  curves again, and a ramp identical to the one already set is not uploaded.
+ *
+ *  Calling this function with exponents of 1.0, a brightness of 1.0 and
+ *  a temperature of 6500 K sets a linear ramp.
+ *
+ *  @param[in] monitor The monitor whose gamma ramp to set.
+ *  @param[in] redGamma The desired exponent for the red channel.
+ *  @param[in] greenGamma The desired exponent for the green channel.
+ *  @param[in] blueGamma The desired exponent for the blue channel.
+ *  @param[in] brightness The desired brightness, from 0.0 to 1.0.
+ *  @param[in] temperature The desired white point color temperature, in
+ *  Kelvin, from 1000 to 40000.  A temperature of 6500 K is neutral.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @wayland Gamma handling is currently unavailable, this function will
+ *  always emit @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref monitor_gamma
+ *  @sa @ref glfwSetGamma
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup monitor
+ */
+GLFWAPI void glfwSetGammaAdjustment(GLFWmonitor* monitor, float redGamma, float greenGamma, float blueGamma, float brightness, float temperature);
+
 /*! @brief Returns the current gamma ramp for the specified monitor.
  *
  *  This function returns the current gamma ramp of the specified monitor.
@@ -2075,6 +2272,9 @@ GLFWAPI const GLFWgammaramp* glfwGetGammaRamp(GLFWmonitor* monitor);
  *  @remark Gamma ramp sizes other than 256 are not supported by all platforms
  *  or graphics hardware.
  *
+ *  @remark If the ramp is identical to the one most recently set by GLFW for
+ *  the monitor, it is not set again.
+ *
  *  @remark @win32 The gamma ramp size must be 256.
  *
  *  @remark @wayland Gamma handling is currently unavailable, this function will
@@ -3484,12 +3684,12 @@ GLFWAPI void glfwPostEmptyEvent(void);
 /*! @brief Returns the value of an input option for the specified window.
  *
  *  This function returns the value of an input option for the specified window.
- *  The mode must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS or
- *  @ref GLFW_STICKY_MOUSE_BUTTONS.
+ *  The mode must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
+ *  @ref GLFW_STICKY_MOUSE_BUTTONS or @ref GLFW_RAW_MOUSE_MOTION.
  *
  *  @param[in] window The window to query.
- *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS` or
- *  `GLFW_STICKY_MOUSE_BUTTONS`.
+ *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
+ *  `GLFW_STICKY_MOUSE_BUTTONS` or `GLFW_RAW_MOUSE_MOTION`.
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
  *  GLFW_INVALID_ENUM.
@@ -3507,8 +3707,8 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
 /*! @brief Sets an input option for the specified window.
  *
  *  This function sets an input mode option for the specified window.  The mode
- *  must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS or
- *  @ref GLFW_STICKY_MOUSE_BUTTONS.
+ *  must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
+ *  @ref GLFW_STICKY_MOUSE_BUTTONS or @ref GLFW_RAW_MOUSE_MOTION.
  *
  *  If the mode is `GLFW_CURSOR`, the value must be one of the following cursor
  *  modes:
@@ -3534,9 +3734,16 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
  *  you are only interested in whether mouse buttons have been pressed but not
  *  when or in which order.
  *
+ *  If the mode is `GLFW_RAW_MOUSE_MOTION`, the value must be either `GLFW_TRUE`
+ *  to enable raw mouse motion, or `GLFW_FALSE` to disable it.  If raw mouse
+ *  motion is enabled, the [raw motion callback](@ref glfwSetRawMotionCallback)
+ *  receives unscaled and unaccelerated mouse motion while the window has input
+ *  focus.  Raw mouse motion is not supported on all systems, see @ref
+ *  glfwRawMouseMotionSupported.
+ *
  *  @param[in] window The window whose input mode to set.
- *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS` or
- *  `GLFW_STICKY_MOUSE_BUTTONS`.
+ *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
+ *  `GLFW_STICKY_MOUSE_BUTTONS` or `GLFW_RAW_MOUSE_MOTION`.
  *  @param[in] value The new value of the specified input mode.
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
@@ -3552,6 +3759,31 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
  */
 GLFWAPI void glfwSetInputMode(GLFWwindow* window, int mode, int value);
 
+/*! @brief Returns whether raw mouse motion is supported.
+ *
+ *  This function returns whether raw mouse motion is supported on the current
+ *  system.  This status does not change after GLFW has been initialized so you
+ *  only need to check this once.  If you attempt to enable raw motion on
+ *  a system that does not support it, @ref GLFW_PLATFORM_ERROR will be emitted.
+ *
+ *  @return `GLFW_TRUE` if raw mouse motion is supported on the current machine,
+ *  or `GLFW_FALSE` otherwise.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark This is currently only supported on X11 with XInput 2.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref raw_mouse_motion
+ *  @sa @ref glfwSetInputMode
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwRawMouseMotionSupported(void);
+
 /*! @brief Returns the layout-specific name of the specified printable key.
  *
  *  This function returns the name of the specified printable key, encoded as
@@ -3738,6 +3970,10 @@ GLFWAPI int glfwGetMouseButton(GLFWwindow* window, int button);
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
  *  GLFW_PLATFORM_ERROR.
  *
+ *  @remark @x11 While the cursor is inside the window, the position is the one
+ *  reported by the most recently processed event rather than queried from the
+ *  X server.
+ *
  *  @thread_safety This function must only be called from the main thread.
  *
  *  @sa @ref cursor_pos
@@ -3827,6 +4063,48 @@ GLFWAPI void glfwSetCursorPos(GLFWwindow* window, double xpos, double ypos);
  */
 GLFWAPI GLFWcursor* glfwCreateCursor(const GLFWimage* image, int xhot, int yhot);
 
+/*! @brief Creates an animated custom cursor.
+ *
+ *  Creates a new custom cursor that cycles through the specified frames, that
+ *  can be set for a window with @ref glfwSetCursor.  The cursor can be
+ *  destroyed with @ref glfwDestroyCursor.  Any remaining cursors are destroyed
+ *  by @ref glfwTerminate.
+ *
+ *  The frames are uploaded once and animated by the window system, so the
+ *  application does not need to replace the cursor to animate it.  The pixels
+ *  of each frame have the same format as for @ref glfwCreateCursor.  The
+ *  frames may have different sizes but share a single hotspot.
+ *
+ *  @param[in] frames The frames of the animation, in order.
+ *  @param[in] delays The time, in milliseconds, that each frame is shown.
+ *  @param[in] count The number of frames and delays.  This must be greater
+ *  than zero.
+ *  @param[in] xhot The desired x-coordinate, in pixels, of the cursor hotspot.
+ *  @param[in] yhot The desired y-coordinate, in pixels, of the cursor hotspot.
+ *  @return The handle of the created cursor, or `NULL` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @pointer_lifetime The specified frames and delays are copied before this
+ *  function returns.
+ *
+ *  @remark Animated cursors are currently only implemented on X11.  On other
+ *  platforms only the first frame is shown.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref cursor_animated
+ *  @sa @ref glfwCreateCursor
+ *  @sa @ref glfwDestroyCursor
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWcursor* glfwCreateAnimatedCursor(const GLFWimage* frames, const int* delays, int count, int xhot, int yhot);
+
 /*! @brief Creates a cursor with a standard shape.
  *
  *  Returns a cursor with a [standard shape](@ref shapes), that can be set for
@@ -4018,6 +4296,35 @@ GLFWAPI GLFWcharfun glfwSetCharCallback(GLFWwindow* window, GLFWcharfun cbfun);
  */
 GLFWAPI GLFWcharmodsfun glfwSetCharModsCallback(GLFWwindow* window, GLFWcharmodsfun cbfun);
 
+/*! @brief Sets the text input callback.
+ *
+ *  This function sets the text input callback of the specified window, which is
+ *  called with the same text as the [character callback](@ref glfwSetCharCallback)
+ *  but as UTF-8 encoded strings.  Text committed at once by an input method,
+ *  for example a CJK candidate selection, is delivered in a single call instead
+ *  of one call per character.
+ *
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] cbfun The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark Text is currently only delivered in runs on X11 when an input method
+ *  is in use.  Elsewhere each character is delivered in its own call.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_char
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWtextfun glfwSetTextCallback(GLFWwindow* window, GLFWtextfun cbfun);
+
 /*! @brief Sets the mouse button callback.
  *
  *  This function sets the mouse button callback of the specified window, which
@@ -4097,6 +4404,32 @@ GLFWAPI GLFWcursorposfun glfwSetCursorPosCallback(GLFWwindow* window, GLFWcursor
  */
 GLFWAPI GLFWcursorenterfun glfwSetCursorEnterCallback(GLFWwindow* window, GLFWcursorenterfun cbfun);
 
+/*! @brief Sets the raw mouse motion callback.
+ *
+ *  This function sets the raw mouse motion callback of the specified window,
+ *  which is called with the raw motion samples received for the window while
+ *  the @ref GLFW_RAW_MOUSE_MOTION input mode is enabled.  The samples are
+ *  batched and delivered once per call to @ref glfwPollEvents or the wait
+ *  functions, keeping the full sub-pixel precision of the device.
+ *
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] cbfun The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref raw_mouse_motion
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWrawmotionfun glfwSetRawMotionCallback(GLFWwindow* window, GLFWrawmotionfun cbfun);
+
 /*! @brief Sets the scroll callback.
  *
  *  This function sets the scroll callback of the specified window, which is
@@ -4550,6 +4883,189 @@ GLFWAPI void glfwSetClipboardString(GLFWwindow* window, const char* string);
  */
 GLFWAPI const char* glfwGetClipboardString(GLFWwindow* window);
 
+/*! @brief Requests the contents of the clipboard as a string.
+ *
+ *  This function requests the contents of the system clipboard and returns
+ *  immediately.  When the contents have arrived, or the request has failed or
+ *  timed out, the specified callback is called with the contents converted to
+ *  a UTF-8 encoded string, or `NULL`.
+ *
+ *  On platforms where the clipboard can be read without waiting for another
+ *  process, the callback is called before this function returns.  Otherwise it
+ *  is called during event processing.
+ *
+ *  Each window can have a single request pending.  Requesting the clipboard
+ *  again before the callback has been called replaces the callback of the
+ *  pending request.
+ *
+ *  @param[in] window The window that will request the clipboard contents.
+ *  @param[in] cbfun The function to call with the contents of the clipboard.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_FORMAT_UNAVAILABLE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @x11 The time allowed for the owner of the clipboard to respond is
+ *  set with the [GLFW_X11_CLIPBOARD_TIMEOUT](@ref GLFW_X11_CLIPBOARD_TIMEOUT)
+ *  init hint.  Large contents are received incrementally as they arrive.
+ *
+ *  @remark @wayland Clipboard is currently unimplemented.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref clipboard
+ *  @sa @ref glfwGetClipboardString
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwRequestClipboardString(GLFWwindow* window, GLFWclipboardfun cbfun);
+
+/*! @brief Sets the clipboard to the specified typed data.
+ *
+ *  This function sets the system clipboard to data of one or more types, for
+ *  example the same image in several formats.  The data is copied before this
+ *  function returns.  Types are arbitrary strings, usually MIME types like
+ *  `image/png`.
+ *
+ *  @param[in] window The window that will own the clipboard contents.
+ *  @param[in] count The number of types.
+ *  @param[in] types The types of the data.
+ *  @param[in] data The data of each type.
+ *  @param[in] sizes The size, in bytes, of the data of each type.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE, @ref GLFW_OUT_OF_MEMORY and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @x11 The types are used as the names of the selection targets.
+ *
+ *  @remark @win32 @macos @wayland Typed clipboard data is currently
+ *  unimplemented.
+ *
+ *  @pointer_lifetime The specified types and data are copied before this
+ *  function returns.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref clipboard_data
+ *  @sa @ref glfwSetClipboardProvider
+ *  @sa @ref glfwGetClipboardData
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwSetClipboardData(GLFWwindow* window, int count, const char** types, const void** data, const size_t* sizes);
+
+/*! @brief Sets the clipboard to typed data provided on demand.
+ *
+ *  This function sets the system clipboard to data of one or more types that
+ *  is only created when it is requested.  The specified callback is called the
+ *  first time data of a type is requested, and the data it returns is kept for
+ *  later requests.  If the data of a type is never requested, the callback is
+ *  never called for it.
+ *
+ *  The callback is called during event processing or from within @ref
+ *  glfwGetClipboardData.  It must not set the clipboard contents.  If the
+ *  window is destroyed, types not yet provided become unavailable.
+ *
+ *  @param[in] window The window that will own the clipboard contents.
+ *  @param[in] count The number of types.
+ *  @param[in] types The types of the data.
+ *  @param[in] cbfun The function that provides the data.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE, @ref GLFW_OUT_OF_MEMORY and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @x11 The types are used as the names of the selection targets.
+ *
+ *  @remark @win32 @macos @wayland Typed clipboard data is currently
+ *  unimplemented.
+ *
+ *  @pointer_lifetime The specified types are copied before this function
+ *  returns.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref clipboard_data
+ *  @sa @ref glfwSetClipboardData
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwSetClipboardProvider(GLFWwindow* window, int count, const char** types, GLFWclipboardproviderfun cbfun);
+
+/*! @brief Returns the types available on the clipboard.
+ *
+ *  This function returns the types the contents of the system clipboard are
+ *  available as.
+ *
+ *  @param[in] window The window that will request the clipboard types.
+ *  @param[out] count Where to store the number of types in the returned
+ *  array.  This is set to zero if the clipboard is empty or an
+ *  [error](@ref error_handling) occurred.
+ *  @return An array of types, or `NULL` if the clipboard is empty or an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @win32 @macos @wayland Typed clipboard data is currently
+ *  unimplemented.
+ *
+ *  @pointer_lifetime The returned array is allocated and freed by GLFW.  You
+ *  should not free it yourself.  It is valid until the next call to this
+ *  function, until the clipboard is set or until the library is terminated.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref clipboard_data
+ *  @sa @ref glfwGetClipboardData
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI const char** glfwGetClipboardTypes(GLFWwindow* window, int* count);
+
+/*! @brief Returns the contents of the clipboard as the specified type.
+ *
+ *  This function returns the contents of the system clipboard as data of the
+ *  specified type.  If the contents are not available as that type, `NULL` is
+ *  returned and a @ref GLFW_FORMAT_UNAVAILABLE error is generated.
+ *
+ *  @param[in] window The window that will request the clipboard contents.
+ *  @param[in] type The type of the requested data.
+ *  @param[out] size Where to store the size, in bytes, of the data.
+ *  @return The data, or `NULL` if an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_FORMAT_UNAVAILABLE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @x11 Large data is received incrementally.  The time allowed for
+ *  the owner of the clipboard to respond is set with the
+ *  [GLFW_X11_CLIPBOARD_TIMEOUT](@ref GLFW_X11_CLIPBOARD_TIMEOUT) init hint.
+ *
+ *  @remark @win32 @macos @wayland Typed clipboard data is currently
+ *  unimplemented.
+ *
+ *  @pointer_lifetime The returned data is allocated and freed by GLFW.  You
+ *  should not free it yourself.  It is valid until the next call to this
+ *  function, until the clipboard is set or until the library is terminated.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref clipboard_data
+ *  @sa @ref glfwGetClipboardTypes
+ *  @sa @ref glfwSetClipboardData
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI const void* glfwGetClipboardData(GLFWwindow* window, const char* type, size_t* size);
+
 /*! @brief Returns the value of the GLFW timer.
  *
  *  This function returns the value of the GLFW timer.  Unless the timer has
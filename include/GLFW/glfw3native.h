@@ -63,6 +63,7 @@ extern "C" {
  *  * `GLFW_EXPOSE_NATIVE_X11`
  *  * `GLFW_EXPOSE_NATIVE_WAYLAND`
  *  * `GLFW_EXPOSE_NATIVE_MIR`
+ *  * `GLFW_EXPOSE_NATIVE_NULL`
  *
  *  The available context API macros are:
  *  * `GLFW_EXPOSE_NATIVE_WGL`
@@ -459,8 +460,9 @@ GLFWAPI EGLSurface glfwGetEGLSurface(GLFWwindow* window);
  *  @param[in] window The window whose color buffer to retrieve.
  *  @param[out] width Where to store the width of the color buffer, or `NULL`.
  *  @param[out] height Where to store the height of the color buffer, or `NULL`.
- *  @param[out] format Where to store the OSMesa pixel format of the color
- *  buffer, or `NULL`.
+ *  @param[out] format Where to store the format of the color buffer,
+ *  which is one of `GLFW_OSMESA_RGBA`, `GLFW_OSMESA_BGRA` or
+ *  `GLFW_OSMESA_RGB_565`, or `NULL`.
  *  @param[out] buffer Where to store the address of the color buffer, or
  *  `NULL`.
  *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
@@ -475,6 +477,124 @@ GLFWAPI EGLSurface glfwGetEGLSurface(GLFWwindow* window);
  */
 GLFWAPI int glfwGetOSMesaColorBuffer(GLFWwindow* window, int* width, int* height, int* format, void** buffer);
 
+/*! @brief Sets the memory the specified window renders its color buffer into.
+ *
+ *  This function makes the OSMesa context of the specified window render
+ *  directly into the specified memory, for example a shared memory segment or
+ *  the input buffer of a video encoder, instead of a buffer allocated by GLFW.
+ *  This avoids having to copy each finished frame out of the context.
+ *
+ *  The memory is used until this function is called again for the same window
+ *  or the window is destroyed.  It must remain valid and be at least `stride *
+ *  height` bytes large for that time.  Pass `NULL` as the buffer to go back to
+ *  a buffer allocated by GLFW.
+ *
+ *  The color buffer has the specified size regardless of the size of the
+ *  window.  If the context is current on the calling thread, the memory is used
+ *  immediately.  Otherwise it is used the next time the context is made
+ *  current.
+ *
+ *  @param[in] window The window whose color buffer to set.
+ *  @param[in] buffer The memory to render into, or `NULL`.
+ *  @param[in] width The width, in pixels, of the color buffer.
+ *  @param[in] height The height, in pixels, of the color buffer.
+ *  @param[in] stride The distance, in bytes, between the starts of two
+ *  consecutive rows, or zero for tightly packed rows.  It must be a multiple
+ *  of the pixel size.
+ *  @param[in] format The pixel format of the memory.  This must be one of
+ *  `GLFW_OSMESA_RGBA`, `GLFW_OSMESA_BGRA` or `GLFW_OSMESA_RGB_565` and match
+ *  the [GLFW_OSMESA_COLOR_FORMAT](@ref GLFW_OSMESA_COLOR_FORMAT_hint) hint the
+ *  window was created with.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_WINDOW_CONTEXT, @ref GLFW_INVALID_ENUM, @ref GLFW_INVALID_VALUE,
+ *  @ref GLFW_FORMAT_UNAVAILABLE, @ref GLFW_API_UNAVAILABLE and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function may be called from any thread.  Access is not
+ *  synchronized.
+ *
+ *  @sa @ref glfwGetOSMesaColorBuffer
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwSetOSMesaColorBuffer(GLFWwindow* window, void* buffer, int width, int height, int stride, int format);
+
+/*! @brief Acquires the most recently completed frame of the specified window.
+ *
+ *  This function acquires the color buffer holding the frame most recently
+ *  completed by @ref glfwSwapBuffers for the specified window, letting another
+ *  thread, for example a video encoder or network streamer, read frame N while
+ *  frame N+1 is rendered.  The window must have been created with a
+ *  [GLFW_OSMESA_BUFFER_COUNT](@ref GLFW_OSMESA_BUFFER_COUNT_hint) of at least
+ *  two.
+ *
+ *  The acquired buffer is not rendered to until the frame is released with
+ *  @ref glfwReleaseOSMesaFrame or another frame is acquired for the same
+ *  window.
+ *  With two buffers, frames completed while the consumer holds the other
+ *  buffer are dropped.  Use three buffers to never drop frames.
+ *
+ *  Each frame is acquired at most once.  If no frame has been completed since
+ *  the last one was acquired, this function releases any acquired frame and
+ *  returns zero without generating an error.
+ *
+ *  @param[in] window The window whose frame to acquire.
+ *  @param[out] width Where to store the width of the frame, or `NULL`.
+ *  @param[out] height Where to store the height of the frame, or `NULL`.
+ *  @param[out] format Where to store the format of the frame, which is one
+ *  of `GLFW_OSMESA_RGBA`, `GLFW_OSMESA_BGRA` or `GLFW_OSMESA_RGB_565`, or
+ *  `NULL`.
+ *  @param[out] buffer Where to store the address of the frame, or `NULL`.
+ *  @return The ID of the acquired frame, which is passed to @ref
+ *  glfwReleaseOSMesaFrame, or zero if no new frame has been completed or an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_WINDOW_CONTEXT, @ref GLFW_API_UNAVAILABLE and @ref
+ *  GLFW_OUT_OF_MEMORY.
+ *
+ *  @pointer_lifetime The returned buffer is valid until the frame is released
+ *  or the library is terminated.  If the window is destroyed first, the frame
+ *  remains valid until it is released.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref glfwReleaseOSMesaFrame
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwAcquireOSMesaFrame(GLFWwindow* window, int* width, int* height, int* format, void** buffer);
+
+/*! @brief Releases an acquired frame.
+ *
+ *  This function releases the frame with the specified ID acquired with @ref
+ *  glfwAcquireOSMesaFrame, allowing its color buffer to be rendered to again.
+ *  If the frame has already been released, this function does nothing.
+ *
+ *  A frame acquired for a window that has since been destroyed is also
+ *  released with this function.
+ *
+ *  @param[in] frame The ID of the frame to release.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref glfwAcquireOSMesaFrame
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwReleaseOSMesaFrame(int frame);
+
 /*! @brief Retrieves the depth buffer associated with the specified window.
  *
  *  @param[in] window The window whose depth buffer to retrieve.
@@ -511,6 +631,237 @@ GLFWAPI int glfwGetOSMesaDepthBuffer(GLFWwindow* window, int* width, int* height
 GLFWAPI OSMesaContext glfwGetOSMesaContext(GLFWwindow* window);
 #endif
 
+#if defined(GLFW_EXPOSE_NATIVE_NULL)
+/*! @brief Sets the frame sink of the specified window.
+ *
+ *  This function makes @ref glfwSwapBuffers hand each finished frame of the
+ *  specified window to a worker thread that writes it to disk or to a pipe, so
+ *  the render loop does not stall on I/O.  Frames are copied into a queue of
+ *  the specified depth.  When the queue is full, the frame is either dropped
+ *  or the swap waits for the worker, depending on the specified policy.
+ *
+ *  If the path begins with `|`, the rest of it is run as a shell command and
+ *  frames are written as a stream to its standard input.  Otherwise the path
+ *  may contain a single integer conversion, for example `frame%05d.png`, which
+ *  is replaced with the frame number to write each frame to its own file.  A
+ *  path without a conversion writes all frames as a stream to one file.
+ *
+ *  Raw frames are written as rendered, with the bottom row first and in the
+ *  [color buffer format](@ref GLFW_OSMESA_COLOR_FORMAT_hint) of the window.
+ *  PPM and PNG frames are written top row first as RGB or RGBA.
+ *
+ *  Any previous sink of the window is flushed and removed.  Pass `NULL` as the
+ *  path to only remove the current sink.  Write errors are reported by the
+ *  next call to @ref glfwSwapBuffers for the window.
+ *
+ *  @param[in] window The window whose frame sink to set.
+ *  @param[in] path The path pattern or command to write frames to, or `NULL`.
+ *  @param[in] format The frame format.  This must be one of
+ *  `GLFW_FRAME_SINK_RAW`, `GLFW_FRAME_SINK_PPM` or `GLFW_FRAME_SINK_PNG`.
+ *  @param[in] depth The maximum number of frames waiting to be written.
+ *  @param[in] policy What to do when the queue is full.  This must be one of
+ *  `GLFW_FRAME_SINK_DROP` or `GLFW_FRAME_SINK_BLOCK`.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_WINDOW_CONTEXT, @ref GLFW_INVALID_ENUM, @ref GLFW_INVALID_VALUE and
+ *  @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @pointer_lifetime The specified path is copied before this function
+ *  returns.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwSetNullFrameSink(GLFWwindow* window, const char* path, int format, int depth, int policy);
+
+/*! @brief Injects a key event for the specified window.
+ *
+ *  This function adds a key event for the specified window to the event queue
+ *  of the null platform.  Like all injected events, it is processed by the
+ *  next call to @ref glfwPollEvents, @ref glfwWaitEvents or @ref
+ *  glfwWaitEventsTimeout, in the order it was injected, and wakes up any
+ *  thread waiting for events.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] key The [keyboard key](@ref keys) or `GLFW_KEY_UNKNOWN`.
+ *  @param[in] scancode The platform-specific scancode of the key.
+ *  @param[in] action `GLFW_PRESS`, `GLFW_RELEASE` or `GLFW_REPEAT`.
+ *  @param[in] mods Bit field describing which [modifier keys](@ref mods) were
+ *  held down.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM and @ref GLFW_OUT_OF_MEMORY.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwInjectNullKey(GLFWwindow* window, int key, int scancode, int action, int mods);
+
+/*! @brief Injects a character event for the specified window.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] codepoint The Unicode code point of the character.
+ *  @param[in] mods Bit field describing which [modifier keys](@ref mods) were
+ *  held down.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_OUT_OF_MEMORY.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref glfwInjectNullKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwInjectNullChar(GLFWwindow* window, unsigned int codepoint, int mods);
+
+/*! @brief Injects a mouse button event for the specified window.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] button The [mouse button](@ref buttons).
+ *  @param[in] action `GLFW_PRESS` or `GLFW_RELEASE`.
+ *  @param[in] mods Bit field describing which [modifier keys](@ref mods) were
+ *  held down.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM and @ref GLFW_OUT_OF_MEMORY.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref glfwInjectNullKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwInjectNullMouseButton(GLFWwindow* window, int button, int action, int mods);
+
+/*! @brief Injects a cursor motion event for the specified window.
+ *
+ *  The position is also reported by @ref glfwGetCursorPos once the event has
+ *  been processed.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] xpos The new cursor x-coordinate, relative to the left edge of
+ *  the content area.
+ *  @param[in] ypos The new cursor y-coordinate, relative to the top edge of the
+ *  content area.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_OUT_OF_MEMORY.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref glfwInjectNullKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwInjectNullCursorPos(GLFWwindow* window, double xpos, double ypos);
+
+/*! @brief Injects a scroll event for the specified window.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] xoffset The scroll offset along the x-axis.
+ *  @param[in] yoffset The scroll offset along the y-axis.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_OUT_OF_MEMORY.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref glfwInjectNullKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwInjectNullScroll(GLFWwindow* window, double xoffset, double yoffset);
+
+/*! @brief Injects a resize event for the specified window.
+ *
+ *  The window and its framebuffer take on the new size when the event is
+ *  processed.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] width The new width, in screen coordinates, of the window.
+ *  @param[in] height The new height, in screen coordinates, of the window.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_OUT_OF_MEMORY.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref glfwInjectNullKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwInjectNullWindowSize(GLFWwindow* window, int width, int height);
+
+/*! @brief Connects a virtual monitor.
+ *
+ *  This function creates a virtual monitor on the null platform and reports
+ *  it to the [monitor callback](@ref monitor_event) like any other connected
+ *  monitor.
+ *
+ *  The description has the form `WxH[@R][,WxH[@R]...][+X+Y][/G]`, listing
+ *  the video modes of the monitor with an optional refresh rate defaulting to
+ *  60 Hz, its optional position and its optional gamma ramp size.  The first
+ *  mode is the current mode.  A monitor without a position is placed to the
+ *  right of the existing monitors.  The gamma ramp size defaults to the
+ *  [GLFW_NULL_GAMMA_RAMP_SIZE](@ref GLFW_NULL_GAMMA_RAMP_SIZE) init hint.
+ *
+ *  @param[in] description The description of the monitor.
+ *  @return The connected monitor, or `NULL` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref glfwDisconnectNullMonitor
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI GLFWmonitor* glfwConnectNullMonitor(const char* description);
+
+/*! @brief Disconnects a virtual monitor.
+ *
+ *  This function disconnects the specified monitor, reports it to the
+ *  [monitor callback](@ref monitor_event) and then destroys it.  Full screen
+ *  windows on the monitor are made windowed first.
+ *
+ *  @param[in] monitor The monitor to disconnect.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref glfwConnectNullMonitor
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwDisconnectNullMonitor(GLFWmonitor* monitor);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -358,6 +358,7 @@ void _glfwPlatformTerminate(void)
     free(_glfw.ns.clipboardString);
 
     _glfwTerminateNSGL();
+    _glfwTerminateOSMesa();
     _glfwTerminateJoysticksNS();
 
     [_glfw.ns.autoreleasePool release];
@@ -1560,6 +1560,15 @@ void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode)
         updateCursorImage(window);
 }
 
+GLFWbool _glfwPlatformRawMouseMotionSupported(void)
+{
+    return GLFW_FALSE;
+}
+
+void _glfwPlatformSetRawMouseMotion(_GLFWwindow* window, GLFWbool enabled)
+{
+}
+
 const char* _glfwPlatformGetKeyName(int key, int scancode)
 {
     if (key != GLFW_KEY_UNKNOWN)
@@ -1650,6 +1659,16 @@ int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
     return GLFW_TRUE;
 }
 
+int _glfwPlatformCreateAnimatedCursor(_GLFWcursor* cursor,
+                                      const GLFWimage* frames,
+                                      const int* delays,
+                                      int count,
+                                      int xhot, int yhot)
+{
+    // TODO: Implement animated cursors
+    return _glfwPlatformCreateCursor(cursor, frames, xhot, yhot);
+}
+
 int _glfwPlatformCreateStandardCursor(_GLFWcursor* cursor, int shape)
 {
     if (!initializeAppKit())
@@ -1726,6 +1745,33 @@ const char* _glfwPlatformGetClipboardString(_GLFWwindow* window)
     return _glfw.ns.clipboardString;
 }
 
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window)
+{
+    _glfwInputClipboardString(_glfwPlatformGetClipboardString(window));
+}
+
+void _glfwPlatformSetClipboardData(_GLFWwindow* window)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Cocoa: Typed clipboard data not implemented yet");
+}
+
+const char** _glfwPlatformGetClipboardTypes(_GLFWwindow* window, int* count)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Cocoa: Typed clipboard data not implemented yet");
+    return NULL;
+}
+
+const void* _glfwPlatformGetClipboardData(_GLFWwindow* window,
+                                          const char* type,
+                                          size_t* size)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Cocoa: Typed clipboard data not implemented yet");
+    return NULL;
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface || !_glfw.vk.MVK_macos_surface)
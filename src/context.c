@@ -210,6 +210,11 @@ const _GLFWfbconfig* _glfwChooseFBConfig(const _GLFWfbconfig* desired,
             }
         }
 
+        // Only a strictly better config can replace the closest one found so
+        // far, so skip the remaining work as soon as this one is ruled out
+        if (missing > leastMissing)
+            continue;
+
         // These polynomials make many small channel size differences matter
         // less than one large channel size difference
 
@@ -236,6 +241,9 @@ const _GLFWfbconfig* _glfwChooseFBConfig(const _GLFWfbconfig* desired,
             }
         }
 
+        if (missing == leastMissing && colorDiff > leastColorDiff)
+            continue;
+
         // Calculate non-color channel size difference value
         {
             extraDiff = 0;
@@ -312,6 +320,10 @@ const _GLFWfbconfig* _glfwChooseFBConfig(const _GLFWfbconfig* desired,
             leastMissing = missing;
             leastColorDiff = colorDiff;
             leastExtraDiff = extraDiff;
+
+            // Nothing can be strictly better than an exact match
+            if (missing == 0 && colorDiff == 0 && extraDiff == 0)
+                break;
         }
     }
 
@@ -52,6 +52,17 @@ static _GLFWinitconfig _glfwInitHints =
     {
         GLFW_TRUE, // menubar
         GLFW_TRUE  // chdir
+    },
+    {
+        64,        // pool limit
+        GLFW_FALSE // huge pages
+    },
+    {
+        0,         // monitor count
+        256        // gamma ramp size
+    },
+    {
+        1000       // clipboard timeout
     }
 };
 
@@ -119,6 +130,9 @@ static void terminate(void)
     _glfwTerminateVulkan();
     _glfwPlatformTerminate();
 
+    // The platform may have handed the clipboard to a clipboard manager
+    _glfwFreeClipboardOffer();
+
     _glfw.initialized = GLFW_FALSE;
 
     while (_glfw.errorListHead)
@@ -143,28 +157,13 @@ static void terminate(void)
 void _glfwInputError(int code, const char* format, ...)
 {
     _GLFWerror* error;
-    char description[1024];
-
-    if (format)
-    {
-        int count;
-        va_list vl;
-
-        va_start(vl, format);
-        count = vsnprintf(description, sizeof(description), format, vl);
-        va_end(vl);
-
-        if (count < 0)
-            description[sizeof(description) - 1] = '\0';
-    }
-    else
-        strcpy(description, getErrorString(code));
 
     if (_glfw.initialized)
     {
         error = _glfwPlatformGetTls(&_glfw.errorSlot);
         if (!error)
         {
+            // This is the only allocation and lock, once per thread
             error = calloc(1, sizeof(_GLFWerror));
             _glfwPlatformSetTls(&_glfw.errorSlot, error);
             _glfwPlatformLockMutex(&_glfw.errorLock);
@@ -177,10 +176,32 @@ void _glfwInputError(int code, const char* format, ...)
         error = &_glfwMainThreadError;
 
     error->code = code;
-    strcpy(error->description, description);
+    error->count++;
+
+    if (!format)
+        error->description = getErrorString(code);
+    else if (!strchr(format, '%'))
+    {
+        // Descriptions without conversions are used as-is
+        error->description = format;
+    }
+    else
+    {
+        int count;
+        va_list vl;
+
+        va_start(vl, format);
+        count = vsnprintf(error->buffer, sizeof(error->buffer), format, vl);
+        va_end(vl);
+
+        if (count < 0)
+            error->buffer[sizeof(error->buffer) - 1] = '\0';
+
+        error->description = error->buffer;
+    }
 
     if (_glfwErrorCallback)
-        _glfwErrorCallback(code, description);
+        _glfwErrorCallback(code, error->description);
 }
 
 
@@ -241,6 +262,45 @@ GLFWAPI void glfwInitHint(int hint, int value)
         case GLFW_COCOA_MENUBAR:
             _glfwInitHints.ns.menubar = value;
             return;
+        case GLFW_OSMESA_BUFFER_POOL_LIMIT:
+            if (value < 0)
+            {
+                _glfwInputError(GLFW_INVALID_VALUE,
+                                "Invalid OSMesa buffer pool limit %i", value);
+                return;
+            }
+            _glfwInitHints.osmesa.poolLimit = value;
+            return;
+        case GLFW_OSMESA_HUGE_PAGES:
+            _glfwInitHints.osmesa.hugePages = value;
+            return;
+        case GLFW_NULL_MONITOR_COUNT:
+            if (value < 0)
+            {
+                _glfwInputError(GLFW_INVALID_VALUE,
+                                "Invalid null monitor count %i", value);
+                return;
+            }
+            _glfwInitHints.null.monitorCount = value;
+            return;
+        case GLFW_NULL_GAMMA_RAMP_SIZE:
+            if (value < 0)
+            {
+                _glfwInputError(GLFW_INVALID_VALUE,
+                                "Invalid null gamma ramp size %i", value);
+                return;
+            }
+            _glfwInitHints.null.gammaSize = value;
+            return;
+        case GLFW_X11_CLIPBOARD_TIMEOUT:
+            if (value <= 0)
+            {
+                _glfwInputError(GLFW_INVALID_VALUE,
+                                "Invalid X11 clipboard timeout %i", value);
+                return;
+            }
+            _glfwInitHints.x11.clipboardTimeout = value;
+            return;
     }
 
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid init hint 0x%08X", hint);
@@ -285,6 +345,21 @@ GLFWAPI int glfwGetError(const char** description)
     return code;
 }
 
+GLFWAPI uint64_t glfwGetErrorCount(void)
+{
+    _GLFWerror* error;
+
+    if (_glfw.initialized)
+        error = _glfwPlatformGetTls(&_glfw.errorSlot);
+    else
+        error = &_glfwMainThreadError;
+
+    if (error)
+        return error->count;
+
+    return 0;
+}
+
 GLFWAPI GLFWerrorfun glfwSetErrorCallback(GLFWerrorfun cbfun)
 {
     _GLFW_SWAP_POINTERS(_glfwErrorCallback, cbfun);
@@ -42,6 +42,37 @@
 #define _GLFW_JOYSTICK_BUTTON   2
 #define _GLFW_JOYSTICK_HATBIT   3
 
+// Replaces the clipboard offer with one for the specified types
+//
+static GLFWbool createClipboardOffer(_GLFWwindow* window,
+                                     int count,
+                                     const char** types)
+{
+    int i;
+
+    _glfwFreeClipboardOffer();
+
+    _glfw.clipboard.types = calloc(count, sizeof(_GLFWclipboardtype));
+    _glfw.clipboard.names = calloc(count, sizeof(char*));
+    if (!_glfw.clipboard.types || !_glfw.clipboard.names)
+    {
+        _glfwFreeClipboardOffer();
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
+
+    _glfw.clipboard.count = count;
+    _glfw.clipboard.window = window;
+
+    for (i = 0;  i < count;  i++)
+    {
+        _glfw.clipboard.types[i].name = strdup(types[i]);
+        _glfw.clipboard.names[i] = _glfw.clipboard.types[i].name;
+    }
+
+    return GLFW_TRUE;
+}
+
 // Finds a mapping based on joystick GUID
 //
 static _GLFWmapping* findMapping(const char* guid)
@@ -168,6 +199,29 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
 }
 
 
+// Decode a Unicode code point from a UTF-8 stream
+// Based on cutef8 by Jeff Bezanson (Public Domain)
+//
+static unsigned int decodeUTF8(const char** s)
+{
+    unsigned int ch = 0, count = 0;
+    static const unsigned int offsets[] =
+    {
+        0x00000000u, 0x00003080u, 0x000e2080u,
+        0x03c82080u, 0xfa082080u, 0x82082080u
+    };
+
+    do
+    {
+        ch = (ch << 6) + (unsigned char) **s;
+        (*s)++;
+        count++;
+    } while ((**s & 0xc0) == 0x80);
+
+    assert(count <= 6);
+    return ch - offsets[count - 1];
+}
+
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
 //////////////////////////////////////////////////////////////////////////
@@ -209,6 +263,49 @@ void _glfwInputChar(_GLFWwindow* window, unsigned int codepoint, int mods, GLFWb
     {
         if (window->callbacks.character)
             window->callbacks.character((GLFWwindow*) window, codepoint);
+
+        if (window->callbacks.text)
+        {
+            char text[5];
+            text[_glfwEncodeUTF8(text, codepoint)] = '\0';
+            window->callbacks.text((GLFWwindow*) window, text);
+        }
+    }
+}
+
+void _glfwInputText(_GLFWwindow* window, char* text, int mods, GLFWbool plain)
+{
+    const char* c = text;
+    char* end = text;
+
+    while (*c)
+    {
+        const char* start = c;
+        const unsigned int codepoint = decodeUTF8(&c);
+
+        if (codepoint < 32 || (codepoint > 126 && codepoint < 160))
+            continue;
+
+        if (window->callbacks.charmods)
+            window->callbacks.charmods((GLFWwindow*) window, codepoint, mods);
+
+        if (plain)
+        {
+            if (window->callbacks.character)
+                window->callbacks.character((GLFWwindow*) window, codepoint);
+        }
+
+        // Compact the printable characters in place for the text callback
+        while (start < c)
+            *end++ = *start++;
+    }
+
+    *end = '\0';
+
+    if (plain && end != text)
+    {
+        if (window->callbacks.text)
+            window->callbacks.text((GLFWwindow*) window, text);
     }
 }
 
@@ -250,12 +347,53 @@ void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered)
         window->callbacks.cursorEnter((GLFWwindow*) window, entered);
 }
 
+void _glfwInputRawMotion(_GLFWwindow* window,
+                         const GLFWrawmotion* samples,
+                         int count)
+{
+    if (window->callbacks.rawMotion)
+        window->callbacks.rawMotion((GLFWwindow*) window, samples, count);
+}
+
 void _glfwInputDrop(_GLFWwindow* window, int count, const char** paths)
 {
     if (window->callbacks.drop)
         window->callbacks.drop((GLFWwindow*) window, count, paths);
 }
 
+void _glfwInputClipboardString(const char* string)
+{
+    _GLFWwindow* window;
+
+    // Requests made by the callbacks below must wait for the next completion,
+    // so only the requests pending now are completed by this string
+    for (window = _glfw.windowListHead;  window;  window = window->next)
+    {
+        window->clipboardCompletion = window->clipboardRequest;
+        window->clipboardRequest = NULL;
+    }
+
+    // The window list is searched again after each callback, as the callback
+    // may have destroyed windows
+    for (;;)
+    {
+        GLFWclipboardfun cbfun;
+
+        for (window = _glfw.windowListHead;  window;  window = window->next)
+        {
+            if (window->clipboardCompletion)
+                break;
+        }
+
+        if (!window)
+            break;
+
+        cbfun = window->clipboardCompletion;
+        window->clipboardCompletion = NULL;
+        cbfun((GLFWwindow*) window, string);
+    }
+}
+
 void _glfwInputJoystick(_GLFWjoystick* js, int event)
 {
     if (_glfw.callbacks.joystick)
@@ -289,6 +427,37 @@ void _glfwInputJoystickHat(_GLFWjoystick* js, int hat, char value)
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
 
+// Encode a Unicode code point to a UTF-8 stream
+// Based on cutef8 by Jeff Bezanson (Public Domain)
+//
+size_t _glfwEncodeUTF8(char* s, unsigned int ch)
+{
+    size_t count = 0;
+
+    if (ch < 0x80)
+        s[count++] = (char) ch;
+    else if (ch < 0x800)
+    {
+        s[count++] = (ch >> 6) | 0xc0;
+        s[count++] = (ch & 0x3f) | 0x80;
+    }
+    else if (ch < 0x10000)
+    {
+        s[count++] = (ch >> 12) | 0xe0;
+        s[count++] = ((ch >> 6) & 0x3f) | 0x80;
+        s[count++] = (ch & 0x3f) | 0x80;
+    }
+    else if (ch < 0x110000)
+    {
+        s[count++] = (ch >> 18) | 0xf0;
+        s[count++] = ((ch >> 12) & 0x3f) | 0x80;
+        s[count++] = ((ch >> 6) & 0x3f) | 0x80;
+        s[count++] = (ch & 0x3f) | 0x80;
+    }
+
+    return count;
+}
+
 GLFWbool _glfwIsPrintable(int key)
 {
     return (key >= GLFW_KEY_APOSTROPHE && key <= GLFW_KEY_WORLD_2) ||
@@ -330,6 +499,69 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
     return js;
 }
 
+const void* _glfwGetOfferedClipboardData(const char* type, size_t* size)
+{
+    int i;
+    _GLFWclipboardtype* entry;
+
+    for (i = 0;  i < _glfw.clipboard.count;  i++)
+    {
+        if (strcmp(_glfw.clipboard.types[i].name, type) == 0)
+            break;
+    }
+
+    if (i == _glfw.clipboard.count)
+        return NULL;
+
+    entry = _glfw.clipboard.types + i;
+
+    if (!entry->provided && _glfw.clipboard.provider)
+    {
+        // Each type is provided at most once and then kept for later requests
+        size_t providedSize = 0;
+        const void* data =
+            _glfw.clipboard.provider((GLFWwindow*) _glfw.clipboard.window,
+                                     entry->name,
+                                     &providedSize);
+
+        entry->provided = GLFW_TRUE;
+
+        if (data)
+        {
+            entry->data = malloc(providedSize ? providedSize : 1);
+            if (!entry->data)
+            {
+                _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+                return NULL;
+            }
+
+            memcpy(entry->data, data, providedSize);
+            entry->size = providedSize;
+        }
+    }
+
+    if (!entry->data)
+        return NULL;
+
+    *size = entry->size;
+    return entry->data;
+}
+
+void _glfwFreeClipboardOffer(void)
+{
+    int i;
+
+    for (i = 0;  i < _glfw.clipboard.count;  i++)
+    {
+        free(_glfw.clipboard.types[i].name);
+        free(_glfw.clipboard.types[i].data);
+    }
+
+    free(_glfw.clipboard.types);
+    free(_glfw.clipboard.names);
+    memset(&_glfw.clipboard, 0, sizeof(_glfw.clipboard));
+}
+
 void _glfwFreeJoystick(_GLFWjoystick* js)
 {
     free(js->name);
@@ -359,6 +591,8 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* handle, int mode)
             return window->stickyKeys;
         case GLFW_STICKY_MOUSE_BUTTONS:
             return window->stickyMouseButtons;
+        case GLFW_RAW_MOUSE_MOTION:
+            return window->rawMouseMotion;
         default:
             _glfwInputError(GLFW_INVALID_ENUM, "Invalid input mode 0x%08X", mode);
             return 0;
@@ -442,11 +676,35 @@ GLFWAPI void glfwSetInputMode(GLFWwindow* handle, int mode, int value)
             window->stickyMouseButtons = value ? GLFW_TRUE : GLFW_FALSE;
             return;
         }
+
+        case GLFW_RAW_MOUSE_MOTION:
+        {
+            if (!_glfwPlatformRawMouseMotionSupported())
+            {
+                _glfwInputError(GLFW_PLATFORM_ERROR,
+                                "Raw mouse motion is not supported on this system");
+                return;
+            }
+
+            value = value ? GLFW_TRUE : GLFW_FALSE;
+            if (window->rawMouseMotion == value)
+                return;
+
+            window->rawMouseMotion = value;
+            _glfwPlatformSetRawMouseMotion(window, value);
+            return;
+        }
     }
 
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid input mode 0x%08X", mode);
 }
 
+GLFWAPI int glfwRawMouseMotionSupported(void)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+    return _glfwPlatformRawMouseMotionSupported();
+}
+
 GLFWAPI const char* glfwGetKeyName(int key, int scancode)
 {
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
@@ -588,6 +846,49 @@ GLFWAPI GLFWcursor* glfwCreateCursor(const GLFWimage* image, int xhot, int yhot)
     return (GLFWcursor*) cursor;
 }
 
+GLFWAPI GLFWcursor* glfwCreateAnimatedCursor(const GLFWimage* frames,
+                                             const int* delays,
+                                             int count,
+                                             int xhot, int yhot)
+{
+    int i;
+    _GLFWcursor* cursor;
+
+    assert(frames != NULL);
+    assert(delays != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    if (count <= 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid frame count %i", count);
+        return NULL;
+    }
+
+    for (i = 0;  i < count;  i++)
+    {
+        if (delays[i] < 0)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "Invalid frame delay %i", delays[i]);
+            return NULL;
+        }
+    }
+
+    cursor = calloc(1, sizeof(_GLFWcursor));
+    cursor->next = _glfw.cursorListHead;
+    _glfw.cursorListHead = cursor;
+
+    if (!_glfwPlatformCreateAnimatedCursor(cursor, frames, delays, count,
+                                           xhot, yhot))
+    {
+        glfwDestroyCursor((GLFWcursor*) cursor);
+        return NULL;
+    }
+
+    return (GLFWcursor*) cursor;
+}
+
 GLFWAPI GLFWcursor* glfwCreateStandardCursor(int shape)
 {
     _GLFWcursor* cursor;
@@ -696,6 +997,16 @@ GLFWAPI GLFWcharmodsfun glfwSetCharModsCallback(GLFWwindow* handle, GLFWcharmods
     return cbfun;
 }
 
+GLFWAPI GLFWtextfun glfwSetTextCallback(GLFWwindow* handle, GLFWtextfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(window->callbacks.text, cbfun);
+    return cbfun;
+}
+
 GLFWAPI GLFWmousebuttonfun glfwSetMouseButtonCallback(GLFWwindow* handle,
                                                       GLFWmousebuttonfun cbfun)
 {
@@ -729,6 +1040,17 @@ GLFWAPI GLFWcursorenterfun glfwSetCursorEnterCallback(GLFWwindow* handle,
     return cbfun;
 }
 
+GLFWAPI GLFWrawmotionfun glfwSetRawMotionCallback(GLFWwindow* handle,
+                                                  GLFWrawmotionfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(window->callbacks.rawMotion, cbfun);
+    return cbfun;
+}
+
 GLFWAPI GLFWscrollfun glfwSetScrollCallback(GLFWwindow* handle,
                                             GLFWscrollfun cbfun)
 {
@@ -1078,6 +1400,8 @@ GLFWAPI void glfwSetClipboardString(GLFWwindow* handle, const char* string)
     assert(string != NULL);
 
     _GLFW_REQUIRE_INIT();
+
+    _glfwFreeClipboardOffer();
     _glfwPlatformSetClipboardString(window, string);
 }
 
@@ -1090,6 +1414,119 @@ GLFWAPI const char* glfwGetClipboardString(GLFWwindow* handle)
     return _glfwPlatformGetClipboardString(window);
 }
 
+GLFWAPI void glfwRequestClipboardString(GLFWwindow* handle,
+                                        GLFWclipboardfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(cbfun != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    window->clipboardRequest = cbfun;
+    _glfwPlatformRequestClipboardString(window);
+}
+
+GLFWAPI void glfwSetClipboardData(GLFWwindow* handle,
+                                  int count,
+                                  const char** types,
+                                  const void** data,
+                                  const size_t* sizes)
+{
+    int i;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(count > 0);
+    assert(types != NULL);
+    assert(data != NULL);
+    assert(sizes != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (count <= 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid clipboard type count %i", count);
+        return;
+    }
+
+    if (!createClipboardOffer(window, count, types))
+        return;
+
+    for (i = 0;  i < count;  i++)
+    {
+        _GLFWclipboardtype* entry = _glfw.clipboard.types + i;
+
+        entry->data = malloc(sizes[i] ? sizes[i] : 1);
+        if (!entry->data)
+        {
+            _glfwFreeClipboardOffer();
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return;
+        }
+
+        memcpy(entry->data, data[i], sizes[i]);
+        entry->size = sizes[i];
+        entry->provided = GLFW_TRUE;
+    }
+
+    _glfwPlatformSetClipboardData(window);
+}
+
+GLFWAPI void glfwSetClipboardProvider(GLFWwindow* handle,
+                                      int count,
+                                      const char** types,
+                                      GLFWclipboardproviderfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(count > 0);
+    assert(types != NULL);
+    assert(cbfun != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (count <= 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid clipboard type count %i", count);
+        return;
+    }
+
+    if (!createClipboardOffer(window, count, types))
+        return;
+
+    _glfw.clipboard.provider = cbfun;
+    _glfwPlatformSetClipboardData(window);
+}
+
+GLFWAPI const char** glfwGetClipboardTypes(GLFWwindow* handle, int* count)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(count != NULL);
+
+    *count = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    return _glfwPlatformGetClipboardTypes(window, count);
+}
+
+GLFWAPI const void* glfwGetClipboardData(GLFWwindow* handle,
+                                         const char* type,
+                                         size_t* size)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(type != NULL);
+    assert(size != NULL);
+
+    *size = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    return _glfwPlatformGetClipboardData(window, type, size);
+}
+
 GLFWAPI double glfwGetTime(void)
 {
     _GLFW_REQUIRE_INIT_OR_RETURN(0.0);
@@ -71,6 +71,7 @@ typedef struct _GLFWmapping     _GLFWmapping;
 typedef struct _GLFWjoystick    _GLFWjoystick;
 typedef struct _GLFWtls         _GLFWtls;
 typedef struct _GLFWmutex       _GLFWmutex;
+typedef struct _GLFWclipboardtype _GLFWclipboardtype;
 
 typedef void (* _GLFWmakecontextcurrentfun)(_GLFWwindow*);
 typedef void (* _GLFWswapbuffersfun)(_GLFWwindow*);
@@ -108,6 +109,7 @@ typedef void (APIENTRY * PFNGLCLEARPROC)(GLbitfield);
 typedef const GLubyte* (APIENTRY * PFNGLGETSTRINGPROC)(GLenum);
 typedef void (APIENTRY * PFNGLGETINTEGERVPROC)(GLenum,GLint*);
 typedef const GLubyte* (APIENTRY * PFNGLGETSTRINGIPROC)(GLenum,GLuint);
+typedef void (APIENTRY * PFNGLFINISHPROC)(void);
 
 #define VK_NULL_HANDLE 0
 
@@ -263,7 +265,11 @@ struct _GLFWerror
 {
     _GLFWerror*     next;
     int             code;
-    char            description[1024];
+    // Number of errors reported on this thread
+    uint64_t        count;
+    // Points to a static string or to the buffer
+    const char*     description;
+    char            buffer[1024];
 };
 
 /*! @brief Initialization configuration.
@@ -277,6 +283,17 @@ struct _GLFWinitconfig
         GLFWbool  menubar;
         GLFWbool  chdir;
     } ns;
+    struct {
+        int       poolLimit;
+        GLFWbool  hugePages;
+    } osmesa;
+    struct {
+        int       monitorCount;
+        int       gammaSize;
+    } null;
+    struct {
+        int       clipboardTimeout;
+    } x11;
 };
 
 /*! @brief Window configuration.
@@ -326,6 +343,10 @@ struct _GLFWctxconfig
     struct {
         GLFWbool  offline;
     } nsgl;
+    struct {
+        int       format;
+        int       buffers;
+    } osmesa;
 };
 
 /*! @brief Framebuffer configuration.
@@ -411,6 +432,7 @@ struct _GLFWwindow
     GLFWbool            stickyKeys;
     GLFWbool            stickyMouseButtons;
     int                 cursorMode;
+    GLFWbool            rawMouseMotion;
     char                mouseButtons[GLFW_MOUSE_BUTTON_LAST + 1];
     char                keys[GLFW_KEY_LAST + 1];
     // Virtual cursor position when cursor is disabled
@@ -430,13 +452,19 @@ struct _GLFWwindow
         GLFWmousebuttonfun      mouseButton;
         GLFWcursorposfun        cursorPos;
         GLFWcursorenterfun      cursorEnter;
+        GLFWrawmotionfun        rawMotion;
         GLFWscrollfun           scroll;
         GLFWkeyfun              key;
         GLFWcharfun             character;
         GLFWcharmodsfun         charmods;
+        GLFWtextfun             text;
         GLFWdropfun             drop;
     } callbacks;
 
+    // Pending clipboard request and the request being completed
+    GLFWclipboardfun    clipboardRequest;
+    GLFWclipboardfun    clipboardCompletion;
+
     // This is defined in the window API's platform.h
     _GLFW_PLATFORM_WINDOW_STATE;
 };
@@ -459,6 +487,17 @@ struct _GLFWmonitor
 
     GLFWgammaramp   originalRamp;
     GLFWgammaramp   currentRamp;
+    // The ramp most recently set by GLFW, used to skip identical uploads
+    GLFWgammaramp   appliedRamp;
+
+    // Gamma curves and ramp generated by glfwSetGammaAdjustment
+    struct {
+        float           gamma[3];
+        float           brightness;
+        float           temperature;
+        double*         curves;
+        GLFWgammaramp   ramp;
+    } generated;
 
     // This is defined in the window API's platform.h
     _GLFW_PLATFORM_MONITOR_STATE;
@@ -482,6 +521,16 @@ struct _GLFWmapelement
     uint8_t         value;
 };
 
+/*! @brief Clipboard data of a single type offered by the application.
+ */
+struct _GLFWclipboardtype
+{
+    char*           name;
+    void*           data;
+    size_t          size;
+    GLFWbool        provided;
+};
+
 /*! @brief Gamepad mapping structure
  */
 struct _GLFWmapping
@@ -552,6 +601,15 @@ struct _GLFWlibrary
     _GLFWmapping*       mappings;
     int                 mappingCount;
 
+    // Typed clipboard data offered by the application
+    struct {
+        _GLFWclipboardtype*      types;
+        const char**             names;
+        int                      count;
+        _GLFWwindow*             window;
+        GLFWclipboardproviderfun provider;
+    } clipboard;
+
     _GLFWtls            errorSlot;
     _GLFWtls            contextSlot;
     _GLFWmutex          errorLock;
@@ -625,7 +683,14 @@ const char* _glfwPlatformGetVersionString(void);
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos);
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, double xpos, double ypos);
 void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode);
+GLFWbool _glfwPlatformRawMouseMotionSupported(void);
+void _glfwPlatformSetRawMouseMotion(_GLFWwindow* window, GLFWbool enabled);
 int _glfwPlatformCreateCursor(_GLFWcursor* cursor, const GLFWimage* image, int xhot, int yhot);
+int _glfwPlatformCreateAnimatedCursor(_GLFWcursor* cursor,
+                                      const GLFWimage* frames,
+                                      const int* delays,
+                                      int count,
+                                      int xhot, int yhot);
 int _glfwPlatformCreateStandardCursor(_GLFWcursor* cursor, int shape);
 void _glfwPlatformDestroyCursor(_GLFWcursor* cursor);
 void _glfwPlatformSetCursor(_GLFWwindow* window, _GLFWcursor* cursor);
@@ -637,10 +702,16 @@ void _glfwPlatformGetMonitorPos(_GLFWmonitor* monitor, int* xpos, int* ypos);
 GLFWvidmode* _glfwPlatformGetVideoModes(_GLFWmonitor* monitor, int* count);
 void _glfwPlatformGetVideoMode(_GLFWmonitor* monitor, GLFWvidmode* mode);
 void _glfwPlatformGetGammaRamp(_GLFWmonitor* monitor, GLFWgammaramp* ramp);
-void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp);
+GLFWbool _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp);
 
 void _glfwPlatformSetClipboardString(_GLFWwindow* window, const char* string);
 const char* _glfwPlatformGetClipboardString(_GLFWwindow* window);
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window);
+void _glfwPlatformSetClipboardData(_GLFWwindow* window);
+const char** _glfwPlatformGetClipboardTypes(_GLFWwindow* window, int* count);
+const void* _glfwPlatformGetClipboardData(_GLFWwindow* window,
+                                          const char* type,
+                                          size_t* size);
 
 int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode);
 void _glfwPlatformUpdateGamepadGUID(char* guid);
@@ -791,6 +862,17 @@ void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int m
  */
 void _glfwInputChar(_GLFWwindow* window, unsigned int codepoint, int mods, GLFWbool plain);
 
+/*! @brief Notifies shared code of a run of committed text.
+ *  @param[in] window The window that received the event.
+ *  @param[in] text The NUL-terminated UTF-8 encoded text.  Control characters
+ *  are removed from it in place.
+ *  @param[in] mods Bit field describing which modifier keys were held down.
+ *  @param[in] plain `GLFW_TRUE` if the text is regular text input, or
+ *  `GLFW_FALSE` otherwise.
+ *  @ingroup event
+ */
+void _glfwInputText(_GLFWwindow* window, char* text, int mods, GLFWbool plain);
+
 /*! @brief Notifies shared code of a scroll event.
  *  @param[in] window The window that received the event.
  *  @param[in] xoffset The scroll offset along the x-axis.
@@ -826,6 +908,16 @@ void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos);
  */
 void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered);
 
+/*! @brief Notifies shared code of a batch of raw mouse motion events.
+ *  @param[in] window The window that received the events.
+ *  @param[in] samples The raw motion samples, in the order they were received.
+ *  @param[in] count The number of samples.
+ *  @ingroup event
+ */
+void _glfwInputRawMotion(_GLFWwindow* window,
+                         const GLFWrawmotion* samples,
+                         int count);
+
 /*! @brief Notifies shared code of a monitor connection or disconnection.
  *  @param[in] monitor The monitor that was connected or disconnected.
  *  @param[in] action One of `GLFW_CONNECTED` or `GLFW_DISCONNECTED`.
@@ -845,7 +937,9 @@ void _glfwInputMonitorWindow(_GLFWmonitor* monitor, _GLFWwindow* window);
 /*! @brief Notifies shared code of an error.
  *  @param[in] code The error code most suitable for the error.
  *  @param[in] format The `printf` style format string of the error
- *  description.
+ *  description, or `NULL` to use the generic description of the code.  It must
+ *  have static storage duration, as it is used directly if it contains no
+ *  conversions.
  *  @ingroup event
  */
 #if defined(__GNUC__)
@@ -862,6 +956,12 @@ void _glfwInputError(int code, const char* format, ...);
  */
 void _glfwInputDrop(_GLFWwindow* window, int count, const char** names);
 
+/*! @brief Notifies shared code that a clipboard request has completed.
+ *  @param[in] string The contents of the clipboard, or `NULL`.
+ *  @ingroup event
+ */
+void _glfwInputClipboardString(const char* string);
+
 /*! @brief Notifies shared code of a joystick connection or disconnection.
  *  @param[in] js The joystick that was connected or disconnected.
  *  @param[in] event One of `GLFW_CONNECTED` or `GLFW_DISCONNECTED`.
@@ -990,6 +1090,56 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
   */
 void _glfwFreeJoystick(_GLFWjoystick* js);
 
+/*! @brief Returns the offered clipboard data of the specified type.
+ *  @param[in] type The type of the data.
+ *  @param[out] size Where to store the size of the data.
+ *  @return The data, or `NULL` if the type is not offered or its provider
+ *  failed.
+ *  @ingroup utility
+ */
+const void* _glfwGetOfferedClipboardData(const char* type, size_t* size);
+
+/*! @brief Frees the typed clipboard data offered by the application.
+ *  @ingroup utility
+ */
+void _glfwFreeClipboardOffer(void);
+
+/*! @brief Converts RGBA pixels to ARGB values.
+ *  @param[out] target Where to store the ARGB values.
+ *  @param[in] source The RGBA pixels to convert.
+ *  @param[in] count The number of pixels to convert.
+ *  @ingroup utility
+ */
+void _glfwConvertToARGB(uint32_t* target,
+                        const unsigned char* source,
+                        size_t count);
+
+/*! @brief Converts RGBA pixels to ARGB values with premultiplied alpha.
+ *  @param[out] target Where to store the ARGB values.
+ *  @param[in] source The RGBA pixels to convert.
+ *  @param[in] count The number of pixels to convert.
+ *  @ingroup utility
+ */
+void _glfwConvertToPremultipliedARGB(uint32_t* target,
+                                     const unsigned char* source,
+                                     size_t count);
+
+/*! @brief Converts RGBA pixels to ARGB values stored in longs.
+ *  @param[out] target Where to store the ARGB values.
+ *  @param[in] source The RGBA pixels to convert.
+ *  @param[in] count The number of pixels to convert.
+ *  @ingroup utility
+ *
+ *  This is the format used by 32-bit X11 properties.
+ */
+void _glfwConvertToARGBLong(long* target,
+                            const unsigned char* source,
+                            size_t count);
+
+/*! @ingroup utility
+ */
+size_t _glfwEncodeUTF8(char* s, unsigned int ch);
+
 /*! @ingroup utility
  */
 GLFWbool _glfwIsPrintable(int key);
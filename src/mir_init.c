@@ -214,6 +214,7 @@ int _glfwPlatformInit(void)
 void _glfwPlatformTerminate(void)
 {
     _glfwTerminateEGL();
+    _glfwTerminateOSMesa();
     _glfwTerminateJoysticksLinux();
 
     _glfwDeleteEventQueueMir(_glfw.mir.eventQueue);
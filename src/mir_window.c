@@ -704,18 +704,8 @@ int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
     MirGraphicsRegion region;
     mir_buffer_stream_get_graphics_region(stream, &region);
 
-    unsigned char* pixels = image->pixels;
-    char* dest = region.vaddr;
-    int i;
-
-    for (i = 0; i < i_w * i_h; i++, pixels += 4)
-    {
-        unsigned int alpha = pixels[3];
-        *dest++ = (char)(pixels[2] * alpha / 255);
-        *dest++ = (char)(pixels[1] * alpha / 255);
-        *dest++ = (char)(pixels[0] * alpha / 255);
-        *dest++ = (char)alpha;
-    }
+    _glfwConvertToPremultipliedARGB((uint32_t*) region.vaddr,
+                                    image->pixels, i_w * i_h);
 
     mir_buffer_stream_swap_buffers_sync(stream);
     cursor->mir.customCursor = stream;
@@ -744,6 +734,16 @@ static const char* getSystemCursorName(int shape)
     return NULL;
 }
 
+int _glfwPlatformCreateAnimatedCursor(_GLFWcursor* cursor,
+                                      const GLFWimage* frames,
+                                      const int* delays,
+                                      int count,
+                                      int xhot, int yhot)
+{
+    // TODO: Implement animated cursors
+    return _glfwPlatformCreateCursor(cursor, frames, xhot, yhot);
+}
+
 int _glfwPlatformCreateStandardCursor(_GLFWcursor* cursor, int shape)
 {
     cursor->mir.conf         = NULL;
@@ -830,6 +830,15 @@ void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode)
     }
 }
 
+GLFWbool _glfwPlatformRawMouseMotionSupported(void)
+{
+    return GLFW_FALSE;
+}
+
+void _glfwPlatformSetRawMouseMotion(_GLFWwindow* window, GLFWbool enabled)
+{
+}
+
 const char* _glfwPlatformGetKeyName(int key, int scancode)
 {
     _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -856,6 +865,35 @@ const char* _glfwPlatformGetClipboardString(_GLFWwindow* window)
     return NULL;
 }
 
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window)
+{
+    _glfwInputClipboardString(_glfwPlatformGetClipboardString(window));
+}
+
+void _glfwPlatformSetClipboardData(_GLFWwindow* window)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Mir: Unsupported function %s", __PRETTY_FUNCTION__);
+}
+
+const char** _glfwPlatformGetClipboardTypes(_GLFWwindow* window, int* count)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Mir: Unsupported function %s", __PRETTY_FUNCTION__);
+
+    return NULL;
+}
+
+const void* _glfwPlatformGetClipboardData(_GLFWwindow* window,
+                                          const char* type,
+                                          size_t* size)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Mir: Unsupported function %s", __PRETTY_FUNCTION__);
+
+    return NULL;
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface || !_glfw.vk.KHR_mir_surface)
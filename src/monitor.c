@@ -81,6 +81,179 @@ static GLFWbool refreshVideoModes(_GLFWmonitor* monitor)
     return GLFW_TRUE;
 }
 
+// Calculates the relative red, green and blue intensities of a black body at
+// the specified temperature, in Kelvin
+//
+static void calculateBlackBody(double temperature, double color[3])
+{
+    int i;
+    const double t = temperature / 100.0;
+
+    // NOTE: This is a curve fit of sRGB black body colors, intended for the
+    //       1000 K to 40000 K range
+    if (t <= 66.0)
+    {
+        color[0] = 255.0;
+        color[1] = 99.4708025861 * log(t) - 161.1195681661;
+
+        if (t <= 19.0)
+            color[2] = 0.0;
+        else
+            color[2] = 138.5177312231 * log(t - 10.0) - 305.0447927307;
+    }
+    else
+    {
+        color[0] = 329.698727446 * pow(t - 60.0, -0.1332047592);
+        color[1] = 288.1221695283 * pow(t - 60.0, -0.0755148492);
+        color[2] = 255.0;
+    }
+
+    for (i = 0;  i < 3;  i++)
+    {
+        if (color[i] < 0.0)
+            color[i] = 0.0;
+        else if (color[i] > 255.0)
+            color[i] = 255.0;
+
+        color[i] /= 255.0;
+    }
+}
+
+// Generates a gamma ramp of the specified size, reusing the cached curves and
+// ramp of the monitor where the parameters have not changed
+//
+static const GLFWgammaramp* generateGammaRamp(_GLFWmonitor* monitor,
+                                              const float gamma[3],
+                                              float brightness,
+                                              float temperature,
+                                              unsigned int size)
+{
+    int c;
+    unsigned int i;
+    double white[3], neutral[3];
+    unsigned short* channels[3];
+    const double scale = size > 1 ? 1.0 / (size - 1) : 0.0;
+
+    if (monitor->generated.ramp.size != size)
+    {
+        _glfwFreeGammaArrays(&monitor->generated.ramp);
+        _glfwAllocGammaArrays(&monitor->generated.ramp, size);
+
+        free(monitor->generated.curves);
+        monitor->generated.curves = calloc(size * 3, sizeof(double));
+
+        // Zero is not a valid gamma value, so this forces all curves to update
+        memset(monitor->generated.gamma, 0, sizeof(monitor->generated.gamma));
+    }
+    else if (memcmp(monitor->generated.gamma, gamma, sizeof(float) * 3) == 0 &&
+             monitor->generated.brightness == brightness &&
+             monitor->generated.temperature == temperature)
+    {
+        return &monitor->generated.ramp;
+    }
+
+    // Only the curves whose exponent changed need to be calculated again
+    for (c = 0;  c < 3;  c++)
+    {
+        double* curve = monitor->generated.curves + c * size;
+
+        if (monitor->generated.gamma[c] == gamma[c])
+            continue;
+
+        if (c > 0 && gamma[c] == gamma[c - 1])
+            memcpy(curve, curve - size, size * sizeof(double));
+        else
+        {
+            for (i = 0;  i < size;  i++)
+                curve[i] = pow(i * scale, 1.0 / gamma[c]);
+        }
+
+        monitor->generated.gamma[c] = gamma[c];
+    }
+
+    // The white point is relative to 6500 K, the white point of sRGB
+    calculateBlackBody(temperature, white);
+    calculateBlackBody(6500.0, neutral);
+
+    channels[0] = monitor->generated.ramp.red;
+    channels[1] = monitor->generated.ramp.green;
+    channels[2] = monitor->generated.ramp.blue;
+
+    for (c = 0;  c < 3;  c++)
+    {
+        const double* curve = monitor->generated.curves + c * size;
+        double factor = white[c] / neutral[c];
+        if (factor > 1.0)
+            factor = 1.0;
+
+        factor *= brightness * 65535.0;
+
+        for (i = 0;  i < size;  i++)
+        {
+            double value = curve[i] * factor + 0.5;
+
+            // Clamp to value range
+            if (value > 65535.0)
+                value = 65535.0;
+
+            channels[c][i] = (unsigned short) value;
+        }
+    }
+
+    monitor->generated.brightness = brightness;
+    monitor->generated.temperature = temperature;
+
+    return &monitor->generated.ramp;
+}
+
+// Sets the gamma ramp of the monitor unless it is already the one set
+//
+static void applyGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
+{
+    const size_t size = ramp->size * sizeof(unsigned short);
+
+    if (monitor->appliedRamp.size == ramp->size &&
+        memcmp(monitor->appliedRamp.red, ramp->red, size) == 0 &&
+        memcmp(monitor->appliedRamp.green, ramp->green, size) == 0 &&
+        memcmp(monitor->appliedRamp.blue, ramp->blue, size) == 0)
+    {
+        return;
+    }
+
+    if (!_glfwPlatformSetGammaRamp(monitor, ramp))
+        return;
+
+    if (monitor->appliedRamp.size != ramp->size)
+    {
+        _glfwFreeGammaArrays(&monitor->appliedRamp);
+        _glfwAllocGammaArrays(&monitor->appliedRamp, ramp->size);
+    }
+
+    memcpy(monitor->appliedRamp.red, ramp->red, size);
+    memcpy(monitor->appliedRamp.green, ramp->green, size);
+    memcpy(monitor->appliedRamp.blue, ramp->blue, size);
+}
+
+// Generates and sets a gamma ramp of the size used by the monitor
+//
+static void setGammaAdjustment(_GLFWmonitor* monitor,
+                               const float gamma[3],
+                               float brightness,
+                               float temperature)
+{
+    unsigned int size = 256;
+
+    if (!monitor->originalRamp.size)
+        _glfwPlatformGetGammaRamp(monitor, &monitor->originalRamp);
+
+    // Generate the ramp at the size used by the hardware, if known
+    if (monitor->originalRamp.size)
+        size = monitor->originalRamp.size;
+
+    applyGammaRamp(monitor,
+                   generateGammaRamp(monitor, gamma, brightness, temperature, size));
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
@@ -157,6 +330,9 @@ void _glfwFreeMonitor(_GLFWmonitor* monitor)
 
     _glfwFreeGammaArrays(&monitor->originalRamp);
     _glfwFreeGammaArrays(&monitor->currentRamp);
+    _glfwFreeGammaArrays(&monitor->appliedRamp);
+    _glfwFreeGammaArrays(&monitor->generated.ramp);
+    free(monitor->generated.curves);
 
     free(monitor->modes);
     free(monitor->name);
@@ -360,10 +536,9 @@ GLFWAPI const GLFWvidmode* glfwGetVideoMode(GLFWmonitor* handle)
 
 GLFWAPI void glfwSetGamma(GLFWmonitor* handle, float gamma)
 {
-    int i;
-    unsigned short values[256];
-    GLFWgammaramp ramp;
-    assert(handle != NULL);
+    _GLFWmonitor* monitor = (_GLFWmonitor*) handle;
+    float gammas[3];
+    assert(monitor != NULL);
     assert(gamma == gamma);
     assert(gamma >= 0.f);
     assert(gamma <= FLT_MAX);
@@ -376,28 +551,54 @@ GLFWAPI void glfwSetGamma(GLFWmonitor* handle, float gamma)
         return;
     }
 
-    for (i = 0;  i < 256;  i++)
-    {
-        double value;
+    gammas[0] = gammas[1] = gammas[2] = gamma;
+    setGammaAdjustment(monitor, gammas, 1.f, 6500.f);
+}
+
+GLFWAPI void glfwSetGammaAdjustment(GLFWmonitor* handle,
+                                    float redGamma,
+                                    float greenGamma,
+                                    float blueGamma,
+                                    float brightness,
+                                    float temperature)
+{
+    int i;
+    float gammas[3];
+    _GLFWmonitor* monitor = (_GLFWmonitor*) handle;
+    assert(monitor != NULL);
 
-        // Calculate intensity
-        value = i / 255.0;
-        // Apply gamma curve
-        value = pow(value, 1.0 / gamma) * 65535.0 + 0.5;
+    _GLFW_REQUIRE_INIT();
 
-        // Clamp to value range
-        if (value > 65535.0)
-            value = 65535.0;
+    gammas[0] = redGamma;
+    gammas[1] = greenGamma;
+    gammas[2] = blueGamma;
 
-        values[i] = (unsigned short) value;
+    for (i = 0;  i < 3;  i++)
+    {
+        if (gammas[i] != gammas[i] || gammas[i] <= 0.f || gammas[i] > FLT_MAX)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "Invalid gamma value %f", gammas[i]);
+            return;
+        }
     }
 
-    ramp.red = values;
-    ramp.green = values;
-    ramp.blue = values;
-    ramp.size = 256;
+    if (brightness != brightness || brightness < 0.f || brightness > 1.f)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid brightness %f", brightness);
+        return;
+    }
+
+    if (temperature != temperature ||
+        temperature < 1000.f || temperature > 40000.f)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid color temperature %f", temperature);
+        return;
+    }
 
-    glfwSetGammaRamp(handle, &ramp);
+    setGammaAdjustment(monitor, gammas, brightness, temperature);
 }
 
 GLFWAPI const GLFWgammaramp* glfwGetGammaRamp(GLFWmonitor* handle)
@@ -436,6 +637,6 @@ GLFWAPI void glfwSetGammaRamp(GLFWmonitor* handle, const GLFWgammaramp* ramp)
     if (!monitor->originalRamp.size)
         _glfwPlatformGetGammaRamp(monitor, &monitor->originalRamp);
 
-    _glfwPlatformSetGammaRamp(monitor, ramp);
+    applyGammaRamp(monitor, ramp);
 }
 
@@ -27,6 +27,8 @@
 
 #include "internal.h"
 
+#include <stdlib.h>
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -35,12 +37,22 @@
 int _glfwPlatformInit(void)
 {
     _glfwInitTimerPOSIX();
+
+    pthread_mutex_init(&_glfw.null.eventMutex, NULL);
+    pthread_cond_init(&_glfw.null.eventCond, NULL);
+
+    _glfwPollMonitorsNull();
+
     return GLFW_TRUE;
 }
 
 void _glfwPlatformTerminate(void)
 {
     _glfwTerminateOSMesa();
+
+    free(_glfw.null.events);
+    pthread_cond_destroy(&_glfw.null.eventCond);
+    pthread_mutex_destroy(&_glfw.null.eventMutex);
 }
 
 const char* _glfwPlatformGetVersionString(void)
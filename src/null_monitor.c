@@ -27,6 +27,219 @@
 
 #include "internal.h"
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+// The modes of virtual monitors created with the GLFW_NULL_MONITOR_COUNT hint
+#define _GLFW_NULL_DEFAULT_MONITOR "1920x1080,1280x1024,1280x720,1024x768,800x600,640x480"
+
+
+// Parses a virtual monitor description of the form
+// WxH[@R][,WxH[@R]...][+X+Y][/G], where the first mode is the current mode
+//
+static GLFWbool parseMonitorNull(const char** description,
+                                 _GLFWmonitorNull* result,
+                                 GLFWbool* placed)
+{
+    char* end;
+    const char* c = *description;
+
+    memset(result, 0, sizeof(_GLFWmonitorNull));
+    result->gammaSize = _glfw.hints.init.null.gammaSize;
+    *placed = GLFW_FALSE;
+
+    for (;;)
+    {
+        GLFWvidmode* mode;
+
+        if (result->modeCount == _GLFW_NULL_MAX_MODES)
+            return GLFW_FALSE;
+
+        mode = result->modes + result->modeCount;
+        mode->redBits = mode->greenBits = mode->blueBits = 8;
+        mode->refreshRate = 60;
+
+        mode->width = (int) strtol(c, &end, 10);
+        if (end == c || *end != 'x')
+            return GLFW_FALSE;
+
+        c = end + 1;
+        mode->height = (int) strtol(c, &end, 10);
+        if (end == c)
+            return GLFW_FALSE;
+
+        c = end;
+        if (*c == '@')
+        {
+            c++;
+            mode->refreshRate = (int) strtol(c, &end, 10);
+            if (end == c)
+                return GLFW_FALSE;
+
+            c = end;
+        }
+
+        if (mode->width <= 0 || mode->height <= 0 || mode->refreshRate <= 0)
+            return GLFW_FALSE;
+
+        result->modeCount++;
+
+        if (*c != ',')
+            break;
+
+        c++;
+    }
+
+    if (*c == '+')
+    {
+        c++;
+        result->xpos = (int) strtol(c, &end, 10);
+        if (end == c || *end != '+')
+            return GLFW_FALSE;
+
+        c = end + 1;
+        result->ypos = (int) strtol(c, &end, 10);
+        if (end == c)
+            return GLFW_FALSE;
+
+        c = end;
+        *placed = GLFW_TRUE;
+    }
+
+    if (*c == '/')
+    {
+        c++;
+        result->gammaSize = (int) strtol(c, &end, 10);
+        if (end == c)
+            return GLFW_FALSE;
+
+        c = end;
+    }
+
+    if (result->gammaSize < 0 || result->gammaSize > _GLFW_NULL_MAX_GAMMA_SIZE)
+        return GLFW_FALSE;
+
+    if (*c != '\0' && *c != ';')
+        return GLFW_FALSE;
+
+    *description = c;
+    return GLFW_TRUE;
+}
+
+// Creates and connects a virtual monitor from the start of a description
+//
+static _GLFWmonitor* connectMonitorNull(const char** description)
+{
+    int i;
+    char name[32];
+    GLFWbool placed;
+    _GLFWmonitorNull state;
+    _GLFWmonitor* monitor;
+
+    if (!parseMonitorNull(description, &state, &placed))
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Null: Invalid monitor description %s", *description);
+        return NULL;
+    }
+
+    // Unplaced monitors are lined up to the right of the existing ones
+    if (!placed)
+    {
+        for (i = 0;  i < _glfw.monitorCount;  i++)
+        {
+            const _GLFWmonitorNull* other = &_glfw.monitors[i]->null;
+            const int right = other->xpos +
+                              other->modes[other->currentMode].width;
+
+            if (state.xpos < right)
+                state.xpos = right;
+        }
+    }
+
+    for (i = 0;  i < state.gammaSize;  i++)
+    {
+        const unsigned short value = (unsigned short)
+            (state.gammaSize > 1 ? i * 65535 / (state.gammaSize - 1) : 0);
+
+        state.red[i] = state.green[i] = state.blue[i] = value;
+    }
+
+    // Assume a resolution of 96 DPI for the physical size
+    sprintf(name, "Null %i", ++_glfw.null.monitorSerial);
+    monitor = _glfwAllocMonitor(name,
+                                (int) (state.modes[0].width * 25.4 / 96.0),
+                                (int) (state.modes[0].height * 25.4 / 96.0));
+    monitor->null = state;
+
+    _glfwInputMonitor(monitor, GLFW_CONNECTED, _GLFW_INSERT_LAST);
+    return monitor;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Creates the virtual monitors described by the GLFW_NULL_MONITORS
+// environment variable or, if it is not set, the init hints
+//
+void _glfwPollMonitorsNull(void)
+{
+    const char* description = getenv("GLFW_NULL_MONITORS");
+
+    if (description)
+    {
+        while (*description)
+        {
+            if (!connectMonitorNull(&description))
+                break;
+
+            if (*description == ';')
+                description++;
+        }
+    }
+    else
+    {
+        int i;
+
+        for (i = 0;  i < _glfw.hints.init.null.monitorCount;  i++)
+        {
+            description = _GLFW_NULL_DEFAULT_MONITOR;
+            if (!connectMonitorNull(&description))
+                break;
+        }
+    }
+}
+
+// Set the current video mode for the specified monitor
+//
+void _glfwSetVideoModeNull(_GLFWmonitor* monitor, const GLFWvidmode* desired)
+{
+    int i;
+    const GLFWvidmode* best = _glfwChooseVideoMode(monitor, desired);
+    if (!best)
+        return;
+
+    for (i = 0;  i < monitor->null.modeCount;  i++)
+    {
+        if (_glfwCompareVideoModes(monitor->null.modes + i, best) == 0)
+        {
+            monitor->null.currentMode = i;
+            break;
+        }
+    }
+}
+
+// Restore the saved (original) video mode for the specified monitor
+//
+void _glfwRestoreVideoModeNull(_GLFWmonitor* monitor)
+{
+    monitor->null.currentMode = 0;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -34,22 +247,98 @@
 
 void _glfwPlatformGetMonitorPos(_GLFWmonitor* monitor, int* xpos, int* ypos)
 {
+    if (xpos)
+        *xpos = monitor->null.xpos;
+    if (ypos)
+        *ypos = monitor->null.ypos;
 }
 
 GLFWvidmode* _glfwPlatformGetVideoModes(_GLFWmonitor* monitor, int* found)
 {
-    return NULL;
+    GLFWvidmode* modes = calloc(monitor->null.modeCount, sizeof(GLFWvidmode));
+    memcpy(modes, monitor->null.modes,
+           monitor->null.modeCount * sizeof(GLFWvidmode));
+
+    *found = monitor->null.modeCount;
+    return modes;
 }
 
 void _glfwPlatformGetVideoMode(_GLFWmonitor* monitor, GLFWvidmode* mode)
 {
+    *mode = monitor->null.modes[monitor->null.currentMode];
 }
 
 void _glfwPlatformGetGammaRamp(_GLFWmonitor* monitor, GLFWgammaramp* ramp)
 {
+    const size_t size = monitor->null.gammaSize * sizeof(unsigned short);
+
+    if (!monitor->null.gammaSize)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Gamma ramp access not supported by monitor");
+        return;
+    }
+
+    _glfwAllocGammaArrays(ramp, monitor->null.gammaSize);
+
+    memcpy(ramp->red, monitor->null.red, size);
+    memcpy(ramp->green, monitor->null.green, size);
+    memcpy(ramp->blue, monitor->null.blue, size);
 }
 
-void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
+GLFWbool _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
 {
+    const size_t size = ramp->size * sizeof(unsigned short);
+
+    if (ramp->size != (unsigned int) monitor->null.gammaSize)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Gamma ramp size must match current ramp size");
+        return GLFW_FALSE;
+    }
+
+    memcpy(monitor->null.red, ramp->red, size);
+    memcpy(monitor->null.green, ramp->green, size);
+    memcpy(monitor->null.blue, ramp->blue, size);
+    return GLFW_TRUE;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                        GLFW native API                       //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWAPI GLFWmonitor* glfwConnectNullMonitor(const char* description)
+{
+    assert(description != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    return (GLFWmonitor*) connectMonitorNull(&description);
+}
+
+GLFWAPI void glfwDisconnectNullMonitor(GLFWmonitor* handle)
+{
+    _GLFWwindow* window;
+    _GLFWmonitor* monitor = (_GLFWmonitor*) handle;
+    assert(monitor != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    // Full screen windows on the monitor become windowed
+    for (window = _glfw.windowListHead;  window;  window = window->next)
+    {
+        if (window->monitor == monitor)
+        {
+            _glfwPlatformSetWindowMonitor(window, NULL,
+                                          monitor->null.xpos,
+                                          monitor->null.ypos,
+                                          window->null.width,
+                                          window->null.height,
+                                          0);
+        }
+    }
+
+    _glfwInputMonitor(monitor, GLFW_DISCONNECTED, 0);
 }
 
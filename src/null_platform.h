@@ -26,13 +26,14 @@
 //========================================================================
 
 #include <dlfcn.h>
+#include <stdio.h>
 
 #define _GLFW_PLATFORM_WINDOW_STATE _GLFWwindowNull null
 
 #define _GLFW_PLATFORM_CONTEXT_STATE
-#define _GLFW_PLATFORM_MONITOR_STATE
+#define _GLFW_PLATFORM_MONITOR_STATE _GLFWmonitorNull null
 #define _GLFW_PLATFORM_CURSOR_STATE
-#define _GLFW_PLATFORM_LIBRARY_WINDOW_STATE
+#define _GLFW_PLATFORM_LIBRARY_WINDOW_STATE _GLFWlibraryNull null
 #define _GLFW_PLATFORM_LIBRARY_CONTEXT_STATE
 #define _GLFW_EGL_CONTEXT_STATE
 #define _GLFW_EGL_LIBRARY_CONTEXT_STATE
@@ -52,11 +53,115 @@
  #define _glfw_dlsym(handle, name) dlsym(handle, name)
 #endif
 
+// Frame queued for the frame sink
+//
+typedef struct _GLFWframeNull
+{
+    unsigned char*  data;
+    size_t          size;
+    int             width;
+    int             height;
+    int             format;
+    int             number;
+} _GLFWframeNull;
+
+// Frame sink writing swapped frames on a worker thread
+//
+typedef struct _GLFWsinkNull
+{
+    pthread_t       thread;
+    pthread_mutex_t mutex;
+    // Signaled when a frame is queued or the sink is stopped
+    pthread_cond_t  queued;
+    // Signaled when a frame has been written
+    pthread_cond_t  written;
+
+    FILE*           file;
+    GLFWbool        pipe;
+    char*           pattern;
+    char*           path;
+    int             format;
+    int             policy;
+
+    // Ring of queued frames, with the oldest at head
+    _GLFWframeNull* frames;
+    int             depth;
+    int             head;
+    int             count;
+
+    int             number;
+    GLFWbool        stop;
+    GLFWbool        failed;
+
+    // Used by the worker thread for pixel conversion
+    unsigned char*  scratch;
+    size_t          scratchSize;
+} _GLFWsinkNull;
+
 // Null-specific per-window data
 //
 typedef struct _GLFWwindowNull
 {
     int width;
     int height;
+
+    double xpos;
+    double ypos;
+
+    _GLFWsinkNull*  sink;
+    // The swap function of the context while a frame sink is set
+    _GLFWswapbuffersfun swapBuffers;
 } _GLFWwindowNull;
 
+// Injected event waiting to be processed
+//
+typedef struct _GLFWeventNull
+{
+    int             type;
+    _GLFWwindow*    window;
+    int             ints[4];
+    double          doubles[2];
+} _GLFWeventNull;
+
+// The maximum number of video modes of a virtual monitor
+#define _GLFW_NULL_MAX_MODES 16
+// The maximum gamma ramp size of a virtual monitor
+#define _GLFW_NULL_MAX_GAMMA_SIZE 1024
+
+// Null-specific per-monitor data
+//
+typedef struct _GLFWmonitorNull
+{
+    int             xpos;
+    int             ypos;
+    GLFWvidmode     modes[_GLFW_NULL_MAX_MODES];
+    int             modeCount;
+    int             currentMode;
+    unsigned short  red[_GLFW_NULL_MAX_GAMMA_SIZE];
+    unsigned short  green[_GLFW_NULL_MAX_GAMMA_SIZE];
+    unsigned short  blue[_GLFW_NULL_MAX_GAMMA_SIZE];
+    int             gammaSize;
+} _GLFWmonitorNull;
+
+// Null-specific global data
+//
+typedef struct _GLFWlibraryNull
+{
+    pthread_mutex_t eventMutex;
+    pthread_cond_t  eventCond;
+
+    // Ring of injected events, with the oldest at eventHead
+    _GLFWeventNull* events;
+    int             eventCapacity;
+    int             eventHead;
+    int             eventCount;
+
+    // Used to give each virtual monitor a unique name
+    int             monitorSerial;
+} _GLFWlibraryNull;
+
+void _glfwDestroyFrameSinkNull(_GLFWwindow* window);
+void _glfwPollMonitorsNull(void);
+void _glfwSetVideoModeNull(_GLFWmonitor* monitor, const GLFWvidmode* desired);
+void _glfwRestoreVideoModeNull(_GLFWmonitor* monitor);
+
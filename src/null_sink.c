@@ -0,0 +1,574 @@
+//========================================================================
+// GLFW 3.3 - www.glfw.org
+//------------------------------------------------------------------------
+// Copyright (c) 2016 Google Inc.
+// Copyright (c) 2006-2016 Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+#include "internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <ctype.h>
+#include <assert.h>
+
+// Keep the vendored encoder from clashing with a copy linked by the application
+#define STB_IMAGE_WRITE_STATIC
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#if defined(__GNUC__)
+ #pragma GCC diagnostic push
+ #pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#include <stb_image_write.h>
+#if defined(__GNUC__)
+ #pragma GCC diagnostic pop
+#endif
+
+
+// Checks that a path pattern contains at most one integer conversion of
+// bounded width and reports whether it contains one
+//
+static GLFWbool parsePatternNull(const char* pattern, GLFWbool* sequence)
+{
+    const char* c;
+    int conversions = 0;
+
+    for (c = pattern;  *c;  c++)
+    {
+        if (*c != '%')
+            continue;
+
+        c++;
+        if (*c == '%')
+            continue;
+
+        while (*c == '0' || *c == '-' || *c == '+' || *c == ' ')
+            c++;
+        if (isdigit((unsigned char) *c))
+        {
+            if (strtol(c, (char**) &c, 10) > 32)
+                return GLFW_FALSE;
+        }
+
+        if (*c != 'd' && *c != 'i')
+            return GLFW_FALSE;
+
+        conversions++;
+    }
+
+    if (conversions > 1)
+        return GLFW_FALSE;
+
+    *sequence = (conversions == 1);
+    return GLFW_TRUE;
+}
+
+// Returns the size in bytes of a pixel in the specified OSMesa format
+//
+static int getBytesPerPixelNull(int format)
+{
+    if (format == OSMESA_RGB_565)
+        return 2;
+    else
+        return 4;
+}
+
+// Converts a frame to top-down RGB or RGBA rows in the scratch buffer
+//
+static unsigned char* convertFrameNull(_GLFWsinkNull* sink,
+                                       const _GLFWframeNull* frame,
+                                       int channels)
+{
+    int x, y;
+    const size_t size = (size_t) frame->width * frame->height * channels;
+
+    if (sink->scratchSize < size)
+    {
+        unsigned char* scratch = realloc(sink->scratch, size);
+        if (!scratch)
+            return NULL;
+
+        sink->scratch = scratch;
+        sink->scratchSize = size;
+    }
+
+    for (y = 0;  y < frame->height;  y++)
+    {
+        // OSMesa color buffers store the bottom row first
+        const unsigned char* source = frame->data +
+            (size_t) (frame->height - y - 1) * frame->width *
+            getBytesPerPixelNull(frame->format);
+        unsigned char* target = sink->scratch +
+            (size_t) y * frame->width * channels;
+
+        for (x = 0;  x < frame->width;  x++)
+        {
+            if (frame->format == OSMESA_RGB_565)
+            {
+                const unsigned int pixel = *((const unsigned short*) source);
+                target[0] = (unsigned char) (((pixel >> 11) & 0x1f) * 255 / 31);
+                target[1] = (unsigned char) (((pixel >> 5) & 0x3f) * 255 / 63);
+                target[2] = (unsigned char) ((pixel & 0x1f) * 255 / 31);
+                if (channels == 4)
+                    target[3] = 255;
+            }
+            else if (frame->format == OSMESA_BGRA)
+            {
+                target[0] = source[2];
+                target[1] = source[1];
+                target[2] = source[0];
+                if (channels == 4)
+                    target[3] = source[3];
+            }
+            else
+            {
+                target[0] = source[0];
+                target[1] = source[1];
+                target[2] = source[2];
+                if (channels == 4)
+                    target[3] = source[3];
+            }
+
+            source += getBytesPerPixelNull(frame->format);
+            target += channels;
+        }
+    }
+
+    return sink->scratch;
+}
+
+// Destination of the PNG encoder, which cannot report write failures itself
+//
+typedef struct _GLFWwriterNull
+{
+    FILE*       file;
+    GLFWbool    failed;
+
+} _GLFWwriterNull;
+
+static void writeFuncNull(void* context, void* data, int size)
+{
+    _GLFWwriterNull* writer = context;
+    if (fwrite(data, 1, size, writer->file) != (size_t) size)
+        writer->failed = GLFW_TRUE;
+}
+
+// Writes a frame to the specified file in the format of the sink
+//
+static GLFWbool encodeFrameNull(_GLFWsinkNull* sink,
+                                const _GLFWframeNull* frame,
+                                FILE* file)
+{
+    if (sink->format == GLFW_FRAME_SINK_RAW)
+    {
+        const size_t size = (size_t) frame->width * frame->height *
+                            getBytesPerPixelNull(frame->format);
+        return fwrite(frame->data, 1, size, file) == size;
+    }
+    else if (sink->format == GLFW_FRAME_SINK_PPM)
+    {
+        const size_t size = (size_t) frame->width * frame->height * 3;
+        const unsigned char* pixels = convertFrameNull(sink, frame, 3);
+        if (!pixels)
+            return GLFW_FALSE;
+
+        if (fprintf(file, "P6\n%i %i\n255\n", frame->width, frame->height) < 0)
+            return GLFW_FALSE;
+
+        return fwrite(pixels, 1, size, file) == size;
+    }
+    else
+    {
+        _GLFWwriterNull writer = { file, GLFW_FALSE };
+        const int channels = (frame->format == OSMESA_RGB_565) ? 3 : 4;
+        const unsigned char* pixels = convertFrameNull(sink, frame, channels);
+        if (!pixels)
+            return GLFW_FALSE;
+
+        if (!stbi_write_png_to_func(writeFuncNull, &writer,
+                                    frame->width, frame->height,
+                                    channels, pixels,
+                                    frame->width * channels))
+        {
+            return GLFW_FALSE;
+        }
+
+        return !writer.failed;
+    }
+}
+
+// Writes a frame to its own file or to the stream of the sink
+//
+static GLFWbool writeFrameNull(_GLFWsinkNull* sink, const _GLFWframeNull* frame)
+{
+    GLFWbool result;
+
+    if (sink->file)
+    {
+        result = encodeFrameNull(sink, frame, sink->file);
+        if (fflush(sink->file) != 0)
+            result = GLFW_FALSE;
+    }
+    else
+    {
+        FILE* file;
+
+        sprintf(sink->path, sink->pattern, frame->number);
+
+        file = fopen(sink->path, "wb");
+        if (!file)
+            return GLFW_FALSE;
+
+        result = encodeFrameNull(sink, frame, file);
+        if (fclose(file) != 0)
+            result = GLFW_FALSE;
+    }
+
+    return result;
+}
+
+// Writes queued frames until the sink is stopped and its queue is empty
+//
+static void* sinkThreadMainNull(void* data)
+{
+    _GLFWsinkNull* sink = data;
+
+    pthread_mutex_lock(&sink->mutex);
+
+    for (;;)
+    {
+        GLFWbool result;
+
+        while (!sink->count && !sink->stop)
+            pthread_cond_wait(&sink->queued, &sink->mutex);
+
+        if (!sink->count)
+            break;
+
+        // The producer does not touch queued frames, so the frame can be
+        // written without holding the lock
+        pthread_mutex_unlock(&sink->mutex);
+        result = writeFrameNull(sink, sink->frames + sink->head);
+        pthread_mutex_lock(&sink->mutex);
+
+        if (!result)
+            sink->failed = GLFW_TRUE;
+
+        sink->head = (sink->head + 1) % sink->depth;
+        sink->count--;
+        pthread_cond_signal(&sink->written);
+    }
+
+    pthread_mutex_unlock(&sink->mutex);
+    return NULL;
+}
+
+// Reports a write failure of the worker thread on the calling thread
+// The sink mutex must not be held, as this may call the error callback
+//
+static void reportFailureNull(_GLFWsinkNull* sink)
+{
+    GLFWbool failed;
+
+    pthread_mutex_lock(&sink->mutex);
+    failed = sink->failed;
+    sink->failed = GLFW_FALSE;
+    pthread_mutex_unlock(&sink->mutex);
+
+    // The pattern is only written when the sink is created
+    if (failed)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Failed to write frame to %s",
+                        sink->pattern);
+    }
+}
+
+// Copies the specified completed frame of the window to the queue of its sink
+//
+static void submitFrameNull(_GLFWwindow* window,
+                            int width, int height, int format,
+                            const void* data)
+{
+    int stride, y;
+    size_t size;
+    _GLFWframeNull* frame;
+    _GLFWsinkNull* sink = window->null.sink;
+    const _GLFWcontextOSMesa* context = &window->context.osmesa;
+
+    reportFailureNull(sink);
+
+    pthread_mutex_lock(&sink->mutex);
+
+    if (sink->policy == GLFW_FRAME_SINK_BLOCK)
+    {
+        while (sink->count == sink->depth)
+            pthread_cond_wait(&sink->written, &sink->mutex);
+    }
+
+    if (sink->count == sink->depth)
+    {
+        // The queue is full, so the frame is dropped
+        sink->number++;
+        pthread_mutex_unlock(&sink->mutex);
+        return;
+    }
+
+    frame = sink->frames + (sink->head + sink->count) % sink->depth;
+
+    pthread_mutex_unlock(&sink->mutex);
+
+    size = (size_t) width * height * getBytesPerPixelNull(format);
+    if (frame->size < size)
+    {
+        unsigned char* pixels = realloc(frame->data, size);
+        if (!pixels)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return;
+        }
+
+        frame->data = pixels;
+        frame->size = size;
+    }
+
+    // Application provided color buffers may have padded rows
+    if (context->user.data)
+        stride = context->user.stride;
+    else
+        stride = width * getBytesPerPixelNull(format);
+
+    for (y = 0;  y < height;  y++)
+    {
+        memcpy(frame->data + (size_t) y * width * getBytesPerPixelNull(format),
+               (const unsigned char*) data + (size_t) y * stride,
+               (size_t) width * getBytesPerPixelNull(format));
+    }
+
+    frame->width = width;
+    frame->height = height;
+    frame->format = format;
+
+    pthread_mutex_lock(&sink->mutex);
+
+    frame->number = sink->number++;
+    sink->count++;
+    pthread_cond_signal(&sink->queued);
+
+    pthread_mutex_unlock(&sink->mutex);
+}
+
+static void swapBuffersNull(_GLFWwindow* window)
+{
+    int width, height, format;
+    void* data;
+    GLFWbool complete;
+
+    // Remember the buffer being completed, as the swap may rotate to another
+    complete = OSMesaGetColorBuffer(window->context.osmesa.handle,
+                                    &width, &height, &format, &data);
+
+    // The wrapped swap finishes rendering before returning
+    window->null.swapBuffers(window);
+
+    if (complete)
+        submitFrameNull(window, width, height, format, data);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Writes any queued frames and removes the frame sink of the window
+//
+void _glfwDestroyFrameSinkNull(_GLFWwindow* window)
+{
+    int i;
+    _GLFWsinkNull* sink = window->null.sink;
+
+    if (!sink)
+        return;
+
+    pthread_mutex_lock(&sink->mutex);
+    sink->stop = GLFW_TRUE;
+    pthread_cond_signal(&sink->queued);
+    pthread_mutex_unlock(&sink->mutex);
+
+    pthread_join(sink->thread, NULL);
+
+    reportFailureNull(sink);
+
+    if (sink->file)
+    {
+        if (sink->pipe)
+            pclose(sink->file);
+        else
+            fclose(sink->file);
+    }
+
+    pthread_cond_destroy(&sink->written);
+    pthread_cond_destroy(&sink->queued);
+    pthread_mutex_destroy(&sink->mutex);
+
+    for (i = 0;  i < sink->depth;  i++)
+        free(sink->frames[i].data);
+
+    free(sink->frames);
+    free(sink->scratch);
+    free(sink->pattern);
+    free(sink->path);
+    free(sink);
+
+    window->context.swapBuffers = window->null.swapBuffers;
+    window->null.swapBuffers = NULL;
+    window->null.sink = NULL;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                        GLFW native API                       //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWAPI int glfwSetNullFrameSink(GLFWwindow* handle, const char* path,
+                                 int format, int depth, int policy)
+{
+    GLFWbool sequence = GLFW_FALSE;
+    _GLFWsinkNull* sink;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (window->context.client == GLFW_NO_API)
+    {
+        _glfwInputError(GLFW_NO_WINDOW_CONTEXT,
+                        "Null: Cannot set a frame sink for a window that has no OpenGL context");
+        return GLFW_FALSE;
+    }
+
+    // Any previous sink is flushed before the new one is set up
+    _glfwDestroyFrameSinkNull(window);
+
+    if (!path)
+        return GLFW_TRUE;
+
+    if (format != GLFW_FRAME_SINK_RAW &&
+        format != GLFW_FRAME_SINK_PPM &&
+        format != GLFW_FRAME_SINK_PNG)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM,
+                        "Null: Invalid frame sink format 0x%08X", format);
+        return GLFW_FALSE;
+    }
+
+    if (policy != GLFW_FRAME_SINK_DROP && policy != GLFW_FRAME_SINK_BLOCK)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM,
+                        "Null: Invalid frame sink policy 0x%08X", policy);
+        return GLFW_FALSE;
+    }
+
+    if (depth < 1)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Null: Invalid frame sink depth %i", depth);
+        return GLFW_FALSE;
+    }
+
+    if (path[0] != '|' && !parsePatternNull(path, &sequence))
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Null: Invalid frame sink path %s", path);
+        return GLFW_FALSE;
+    }
+
+    sink = calloc(1, sizeof(_GLFWsinkNull));
+    sink->format = format;
+    sink->policy = policy;
+    sink->depth = depth;
+    sink->frames = calloc(depth, sizeof(_GLFWframeNull));
+    sink->pattern = strdup(path);
+
+    if (path[0] == '|')
+    {
+        // The remainder of the path is a command reading frames from stdin
+        sink->file = popen(path + 1, "w");
+        sink->pipe = GLFW_TRUE;
+    }
+    else if (sequence)
+    {
+        // Leave room for the widest possible frame number
+        sink->path = calloc(strlen(path) + 64, 1);
+    }
+    else
+        sink->file = fopen(path, "wb");
+
+    if (!sink->file && !sequence)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Failed to open frame sink %s: %s",
+                        path, strerror(errno));
+
+        free(sink->frames);
+        free(sink->pattern);
+        free(sink);
+        return GLFW_FALSE;
+    }
+
+    pthread_mutex_init(&sink->mutex, NULL);
+    pthread_cond_init(&sink->queued, NULL);
+    pthread_cond_init(&sink->written, NULL);
+
+    if (pthread_create(&sink->thread, NULL, sinkThreadMainNull, sink) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Failed to create frame sink thread");
+
+        pthread_cond_destroy(&sink->written);
+        pthread_cond_destroy(&sink->queued);
+        pthread_mutex_destroy(&sink->mutex);
+
+        if (sink->file)
+        {
+            if (sink->pipe)
+                pclose(sink->file);
+            else
+                fclose(sink->file);
+        }
+
+        free(sink->frames);
+        free(sink->pattern);
+        free(sink->path);
+        free(sink);
+        return GLFW_FALSE;
+    }
+
+    window->null.sink = sink;
+    window->null.swapBuffers = window->context.swapBuffers;
+    window->context.swapBuffers = swapBuffersNull;
+
+    return GLFW_TRUE;
+}
+
@@ -27,6 +27,205 @@
 
 #include "internal.h"
 
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <assert.h>
+
+#define _GLFW_NULL_EMPTY_EVENT          0
+#define _GLFW_NULL_KEY_EVENT            1
+#define _GLFW_NULL_CHAR_EVENT           2
+#define _GLFW_NULL_MOUSE_BUTTON_EVENT   3
+#define _GLFW_NULL_CURSOR_POS_EVENT     4
+#define _GLFW_NULL_SCROLL_EVENT         5
+#define _GLFW_NULL_WINDOW_SIZE_EVENT    6
+
+
+// Appends an event to the queue and wakes up any waiting thread
+//
+static void pushEventNull(const _GLFWeventNull* event)
+{
+    pthread_mutex_lock(&_glfw.null.eventMutex);
+
+    if (_glfw.null.eventCount == _glfw.null.eventCapacity)
+    {
+        const int oldCapacity = _glfw.null.eventCapacity;
+        const int capacity = oldCapacity ? oldCapacity * 2 : 256;
+        _GLFWeventNull* events = realloc(_glfw.null.events,
+                                         capacity * sizeof(_GLFWeventNull));
+        if (!events)
+        {
+            pthread_mutex_unlock(&_glfw.null.eventMutex);
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return;
+        }
+
+        // The ring is full, so the part wrapped to the start is the events
+        // before the head, which are moved to after the old end
+        memcpy(events + oldCapacity, events,
+               _glfw.null.eventHead * sizeof(_GLFWeventNull));
+
+        _glfw.null.events = events;
+        _glfw.null.eventCapacity = capacity;
+    }
+
+    _glfw.null.events[(_glfw.null.eventHead + _glfw.null.eventCount) %
+                      _glfw.null.eventCapacity] = *event;
+    _glfw.null.eventCount++;
+
+    pthread_cond_signal(&_glfw.null.eventCond);
+    pthread_mutex_unlock(&_glfw.null.eventMutex);
+}
+
+// Removes the oldest event from the queue
+//
+static GLFWbool popEventNull(_GLFWeventNull* event)
+{
+    GLFWbool result = GLFW_FALSE;
+
+    pthread_mutex_lock(&_glfw.null.eventMutex);
+
+    if (_glfw.null.eventCount)
+    {
+        *event = _glfw.null.events[_glfw.null.eventHead];
+        _glfw.null.eventHead = (_glfw.null.eventHead + 1) %
+                               _glfw.null.eventCapacity;
+        _glfw.null.eventCount--;
+        result = GLFW_TRUE;
+    }
+
+    pthread_mutex_unlock(&_glfw.null.eventMutex);
+    return result;
+}
+
+// Removes all events for the specified window from the queue
+//
+static void purgeEventsNull(_GLFWwindow* window)
+{
+    int i, count = 0;
+
+    pthread_mutex_lock(&_glfw.null.eventMutex);
+
+    for (i = 0;  i < _glfw.null.eventCount;  i++)
+    {
+        const _GLFWeventNull* event =
+            _glfw.null.events + (_glfw.null.eventHead + i) % _glfw.null.eventCapacity;
+
+        if (event->window != window)
+        {
+            _glfw.null.events[(_glfw.null.eventHead + count) %
+                              _glfw.null.eventCapacity] = *event;
+            count++;
+        }
+    }
+
+    _glfw.null.eventCount = count;
+
+    pthread_mutex_unlock(&_glfw.null.eventMutex);
+}
+
+// Passes an injected event on to the shared input code
+//
+static void processEventNull(const _GLFWeventNull* event)
+{
+    _GLFWwindow* window = event->window;
+
+    switch (event->type)
+    {
+        case _GLFW_NULL_KEY_EVENT:
+            _glfwInputKey(window,
+                          event->ints[0], event->ints[1],
+                          event->ints[2], event->ints[3]);
+            break;
+
+        case _GLFW_NULL_CHAR_EVENT:
+            _glfwInputChar(window,
+                           (unsigned int) event->ints[0],
+                           event->ints[1], GLFW_TRUE);
+            break;
+
+        case _GLFW_NULL_MOUSE_BUTTON_EVENT:
+            _glfwInputMouseClick(window,
+                                 event->ints[0], event->ints[1],
+                                 event->ints[2]);
+            break;
+
+        case _GLFW_NULL_CURSOR_POS_EVENT:
+            window->null.xpos = event->doubles[0];
+            window->null.ypos = event->doubles[1];
+            _glfwInputCursorPos(window, event->doubles[0], event->doubles[1]);
+            break;
+
+        case _GLFW_NULL_SCROLL_EVENT:
+            _glfwInputScroll(window, event->doubles[0], event->doubles[1]);
+            break;
+
+        case _GLFW_NULL_WINDOW_SIZE_EVENT:
+            window->null.width = event->ints[0];
+            window->null.height = event->ints[1];
+            _glfwInputFramebufferSize(window, event->ints[0], event->ints[1]);
+            _glfwInputWindowSize(window, event->ints[0], event->ints[1]);
+            break;
+    }
+}
+
+// Queues an event of the specified type for the specified window
+//
+static void injectEventNull(_GLFWwindow* window, int type,
+                            int i0, int i1, int i2, int i3,
+                            double d0, double d1)
+{
+    _GLFWeventNull event;
+
+    event.type = type;
+    event.window = window;
+    event.ints[0] = i0;
+    event.ints[1] = i1;
+    event.ints[2] = i2;
+    event.ints[3] = i3;
+    event.doubles[0] = d0;
+    event.doubles[1] = d1;
+
+    pushEventNull(&event);
+}
+
+// Resizes the window and reports the new size
+//
+static void resizeWindowNull(_GLFWwindow* window, int width, int height)
+{
+    if (window->null.width == width && window->null.height == height)
+        return;
+
+    window->null.width = width;
+    window->null.height = height;
+
+    _glfwInputFramebufferSize(window, width, height);
+    _glfwInputWindowSize(window, width, height);
+}
+
+// Make the specified window and its video mode active on its monitor
+//
+static void acquireMonitor(_GLFWwindow* window)
+{
+    GLFWvidmode mode;
+
+    _glfwSetVideoModeNull(window->monitor, &window->videoMode);
+    _glfwPlatformGetVideoMode(window->monitor, &mode);
+    _glfwInputMonitorWindow(window->monitor, window);
+
+    resizeWindowNull(window, mode.width, mode.height);
+}
+
+// Remove the window and restore the original video mode
+//
+static void releaseMonitor(_GLFWwindow* window)
+{
+    if (window->monitor->window != window)
+        return;
+
+    _glfwInputMonitorWindow(window->monitor, NULL);
+    _glfwRestoreVideoModeNull(window->monitor);
+}
 
 static int createNativeWindow(_GLFWwindow* window,
                               const _GLFWwndconfig* wndconfig)
@@ -67,11 +266,20 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
         }
     }
 
+    if (window->monitor)
+        acquireMonitor(window);
+
     return GLFW_TRUE;
 }
 
 void _glfwPlatformDestroyWindow(_GLFWwindow* window)
 {
+    if (window->monitor)
+        releaseMonitor(window);
+
+    purgeEventsNull(window);
+    _glfwDestroyFrameSinkNull(window);
+
     if (window->context.destroy)
         window->context.destroy(window);
 }
@@ -91,6 +299,28 @@ void _glfwPlatformSetWindowMonitor(_GLFWwindow* window,
                                    int width, int height,
                                    int refreshRate)
 {
+    if (window->monitor == monitor)
+    {
+        if (monitor)
+        {
+            if (monitor->window == window)
+                acquireMonitor(window);
+        }
+        else
+            resizeWindowNull(window, width, height);
+
+        return;
+    }
+
+    if (window->monitor)
+        releaseMonitor(window);
+
+    _glfwInputWindowMonitorChange(window, monitor);
+
+    if (window->monitor)
+        acquireMonitor(window);
+    else
+        resizeWindowNull(window, width, height);
 }
 
 void _glfwPlatformGetWindowPos(_GLFWwindow* window, int* xpos, int* ypos)
@@ -206,32 +436,92 @@ int _glfwPlatformWindowVisible(_GLFWwindow* window)
 
 void _glfwPlatformPollEvents(void)
 {
+    int count;
+    _GLFWeventNull event;
+
+    // Events injected by callbacks are left for the next call
+    pthread_mutex_lock(&_glfw.null.eventMutex);
+    count = _glfw.null.eventCount;
+    pthread_mutex_unlock(&_glfw.null.eventMutex);
+
+    while (count-- && popEventNull(&event))
+        processEventNull(&event);
 }
 
 void _glfwPlatformWaitEvents(void)
 {
+    pthread_mutex_lock(&_glfw.null.eventMutex);
+
+    while (!_glfw.null.eventCount)
+        pthread_cond_wait(&_glfw.null.eventCond, &_glfw.null.eventMutex);
+
+    pthread_mutex_unlock(&_glfw.null.eventMutex);
+
+    _glfwPlatformPollEvents();
 }
 
 void _glfwPlatformWaitEventsTimeout(double timeout)
 {
+    struct timespec time;
+
+    clock_gettime(CLOCK_REALTIME, &time);
+    time.tv_sec += (time_t) timeout;
+    time.tv_nsec += (long) ((timeout - (time_t) timeout) * 1e9);
+    if (time.tv_nsec >= 1000000000)
+    {
+        time.tv_sec++;
+        time.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&_glfw.null.eventMutex);
+
+    while (!_glfw.null.eventCount)
+    {
+        if (pthread_cond_timedwait(&_glfw.null.eventCond,
+                                   &_glfw.null.eventMutex,
+                                   &time) != 0)
+        {
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&_glfw.null.eventMutex);
+
+    _glfwPlatformPollEvents();
 }
 
 void _glfwPlatformPostEmptyEvent(void)
 {
+    injectEventNull(NULL, _GLFW_NULL_EMPTY_EVENT, 0, 0, 0, 0, 0.0, 0.0);
 }
 
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
 {
+    if (xpos)
+        *xpos = window->null.xpos;
+    if (ypos)
+        *ypos = window->null.ypos;
 }
 
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, double x, double y)
 {
+    window->null.xpos = x;
+    window->null.ypos = y;
 }
 
 void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode)
 {
 }
 
+GLFWbool _glfwPlatformRawMouseMotionSupported(void)
+{
+    return GLFW_FALSE;
+}
+
+void _glfwPlatformSetRawMouseMotion(_GLFWwindow* window, GLFWbool enabled)
+{
+}
+
 int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
                               const GLFWimage* image,
                               int xhot, int yhot)
@@ -239,6 +529,15 @@ int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
     return GLFW_TRUE;
 }
 
+int _glfwPlatformCreateAnimatedCursor(_GLFWcursor* cursor,
+                                      const GLFWimage* frames,
+                                      const int* delays,
+                                      int count,
+                                      int xhot, int yhot)
+{
+    return GLFW_TRUE;
+}
+
 int _glfwPlatformCreateStandardCursor(_GLFWcursor* cursor, int shape)
 {
     return GLFW_TRUE;
@@ -261,6 +560,35 @@ const char* _glfwPlatformGetClipboardString(_GLFWwindow* window)
     return NULL;
 }
 
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window)
+{
+    _glfwInputClipboardString(_glfwPlatformGetClipboardString(window));
+}
+
+void _glfwPlatformSetClipboardData(_GLFWwindow* window)
+{
+}
+
+const char** _glfwPlatformGetClipboardTypes(_GLFWwindow* window, int* count)
+{
+    *count = _glfw.clipboard.count;
+    return _glfw.clipboard.names;
+}
+
+const void* _glfwPlatformGetClipboardData(_GLFWwindow* window,
+                                          const char* type,
+                                          size_t* size)
+{
+    const void* data = _glfwGetOfferedClipboardData(type, size);
+    if (!data)
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "Null: Clipboard data not available as %s", type);
+    }
+
+    return data;
+}
+
 const char* _glfwPlatformGetKeyName(int key, int scancode)
 {
     return "";
@@ -291,3 +619,108 @@ VkResult _glfwPlatformCreateWindowSurface(VkInstance instance,
     return VK_ERROR_INITIALIZATION_FAILED;
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+//////                        GLFW native API                       //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWAPI void glfwInjectNullKey(GLFWwindow* handle, int key, int scancode,
+                               int action, int mods)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (key != GLFW_KEY_UNKNOWN &&
+        (key < GLFW_KEY_SPACE || key > GLFW_KEY_LAST))
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid key %i", key);
+        return;
+    }
+
+    if (action != GLFW_PRESS && action != GLFW_RELEASE && action != GLFW_REPEAT)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid key action %i", action);
+        return;
+    }
+
+    injectEventNull(window, _GLFW_NULL_KEY_EVENT,
+                    key, scancode, action, mods, 0.0, 0.0);
+}
+
+GLFWAPI void glfwInjectNullChar(GLFWwindow* handle, unsigned int codepoint,
+                                int mods)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    injectEventNull(window, _GLFW_NULL_CHAR_EVENT,
+                    (int) codepoint, mods, 0, 0, 0.0, 0.0);
+}
+
+GLFWAPI void glfwInjectNullMouseButton(GLFWwindow* handle, int button,
+                                       int action, int mods)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (button < GLFW_MOUSE_BUTTON_1 || button > GLFW_MOUSE_BUTTON_LAST)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid mouse button %i", button);
+        return;
+    }
+
+    if (action != GLFW_PRESS && action != GLFW_RELEASE)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM,
+                        "Invalid mouse button action %i", action);
+        return;
+    }
+
+    injectEventNull(window, _GLFW_NULL_MOUSE_BUTTON_EVENT,
+                    button, action, mods, 0, 0.0, 0.0);
+}
+
+GLFWAPI void glfwInjectNullCursorPos(GLFWwindow* handle,
+                                     double xpos, double ypos)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    injectEventNull(window, _GLFW_NULL_CURSOR_POS_EVENT,
+                    0, 0, 0, 0, xpos, ypos);
+}
+
+GLFWAPI void glfwInjectNullScroll(GLFWwindow* handle,
+                                  double xoffset, double yoffset)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    injectEventNull(window, _GLFW_NULL_SCROLL_EVENT,
+                    0, 0, 0, 0, xoffset, yoffset);
+}
+
+GLFWAPI void glfwInjectNullWindowSize(GLFWwindow* handle,
+                                      int width, int height)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(width >= 0);
+    assert(height >= 0);
+
+    _GLFW_REQUIRE_INIT();
+
+    injectEventNull(window, _GLFW_NULL_WINDOW_SIZE_EVENT,
+                    width, height, 0, 0, 0.0, 0.0);
+}
+
@@ -27,35 +27,380 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <assert.h>
 
 #include "internal.h"
 
+#if defined(__linux__)
+ #include <sys/mman.h>
+#endif
 
-static void makeContextCurrentOSMesa(_GLFWwindow* window)
+#define _GLFW_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+
+// Rounds a color buffer size up to the size of its pool bucket
+// Buckets are one eighth of the power of two below the size apart, so nearby
+// sizes share buffers while wasting at most an eighth of the memory
+//
+static size_t getBucketSizeOSMesa(size_t size)
 {
-    if (window)
+    size_t step = 4096;
+
+    while (step * 8 < size)
+        step *= 2;
+
+    if (size < step)
+        size = step;
+
+    return (size + step - 1) & ~(step - 1);
+}
+
+// Allocates a new color buffer of the specified size
+//
+static GLFWbool allocateBufferOSMesa(_GLFWbufferOSMesa* buffer, size_t size)
+{
+    buffer->mapped = GLFW_FALSE;
+    buffer->bucket = size;
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (_glfw.hints.init.osmesa.hugePages && size >= _GLFW_HUGE_PAGE_SIZE)
+    {
+        // Map with enough slack to align the buffer to a huge page boundary
+        // and return the unaligned head and tail to the system
+        const size_t alignedSize = (size + _GLFW_HUGE_PAGE_SIZE - 1) &
+                                   ~((size_t) _GLFW_HUGE_PAGE_SIZE - 1);
+        const size_t mappedSize = alignedSize + _GLFW_HUGE_PAGE_SIZE;
+        char* base = mmap(NULL, mappedSize,
+                          PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS,
+                          -1, 0);
+        if (base != MAP_FAILED)
+        {
+            char* data = (char*) (((uintptr_t) base + _GLFW_HUGE_PAGE_SIZE - 1) &
+                                  ~((uintptr_t) _GLFW_HUGE_PAGE_SIZE - 1));
+            const size_t head = data - base;
+            const size_t tail = mappedSize - head - alignedSize;
+
+            if (head)
+                munmap(base, head);
+            if (tail)
+                munmap(data + alignedSize, tail);
+
+            // This is only advice, so failure here is not an error
+            madvise(data, alignedSize, MADV_HUGEPAGE);
+
+            buffer->data = data;
+            buffer->size = alignedSize;
+            buffer->mapped = GLFW_TRUE;
+            return GLFW_TRUE;
+        }
+    }
+#endif
+
+    buffer->data = calloc(1, size);
+    if (!buffer->data)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY,
+                        "OSMesa: Failed to allocate color buffer");
+        return GLFW_FALSE;
+    }
+
+    buffer->size = size;
+    return GLFW_TRUE;
+}
+
+// Frees the memory of a color buffer
+//
+static void freeBufferOSMesa(_GLFWbufferOSMesa* buffer)
+{
+#if defined(__linux__)
+    if (buffer->mapped)
+        munmap(buffer->data, buffer->size);
+    else
+#endif
+        free(buffer->data);
+
+    memset(buffer, 0, sizeof(_GLFWbufferOSMesa));
+}
+
+// Removes the specified color buffer from the pool
+// The pool lock must be held by the caller
+//
+static void removeBufferOSMesa(int index, _GLFWbufferOSMesa* buffer)
+{
+    *buffer = _glfw.osmesa.pool.buffers[index];
+    _glfw.osmesa.pool.size -= buffer->size;
+    _glfw.osmesa.pool.count--;
+
+    memmove(_glfw.osmesa.pool.buffers + index,
+            _glfw.osmesa.pool.buffers + index + 1,
+            (_glfw.osmesa.pool.count - index) * sizeof(_GLFWbufferOSMesa));
+}
+
+// Retrieves a color buffer of at least the specified size, reusing a pooled
+// buffer of a similar size if one is available
+//
+static GLFWbool acquireBufferOSMesa(_GLFWbufferOSMesa* buffer, size_t size)
+{
+    int i, closest = -1;
+    const size_t bucketSize = getBucketSizeOSMesa(size);
+
+    _glfwPlatformLockMutex(_glfw.osmesa.pool.lock);
+
+    for (i = 0;  i < _glfw.osmesa.pool.count;  i++)
+    {
+        // Match on the bucket, as huge page mappings are rounded up further
+        const size_t pooledSize = _glfw.osmesa.pool.buffers[i].bucket;
+
+        // Do not let a small framebuffer hold on to a much larger buffer
+        if (pooledSize < bucketSize || pooledSize > bucketSize + bucketSize / 4)
+            continue;
+
+        if (closest == -1 || pooledSize < _glfw.osmesa.pool.buffers[closest].bucket)
+            closest = i;
+    }
+
+    if (closest != -1)
+    {
+        removeBufferOSMesa(closest, buffer);
+        _glfwPlatformUnlockMutex(_glfw.osmesa.pool.lock);
+
+        // New buffers start out cleared, so reused ones must as well
+        memset(buffer->data, 0, size);
+        return GLFW_TRUE;
+    }
+
+    _glfwPlatformUnlockMutex(_glfw.osmesa.pool.lock);
+
+    return allocateBufferOSMesa(buffer, bucketSize);
+}
+
+// Returns a color buffer to the pool, evicting the least recently released
+// buffers if the pool would grow beyond its limits
+//
+static void releaseBufferOSMesa(_GLFWbufferOSMesa* buffer)
+{
+    const size_t limit = (size_t) _glfw.hints.init.osmesa.poolLimit << 20;
+
+    if (!buffer->data)
+        return;
+
+    if (buffer->size > limit)
+    {
+        freeBufferOSMesa(buffer);
+        return;
+    }
+
+    _glfwPlatformLockMutex(_glfw.osmesa.pool.lock);
+
+    while (_glfw.osmesa.pool.count == _GLFW_OSMESA_POOL_CAPACITY ||
+           _glfw.osmesa.pool.size + buffer->size > limit)
+    {
+        _GLFWbufferOSMesa evicted;
+        removeBufferOSMesa(0, &evicted);
+        freeBufferOSMesa(&evicted);
+    }
+
+    _glfw.osmesa.pool.buffers[_glfw.osmesa.pool.count++] = *buffer;
+    _glfw.osmesa.pool.size += buffer->size;
+
+    _glfwPlatformUnlockMutex(_glfw.osmesa.pool.lock);
+
+    memset(buffer, 0, sizeof(_GLFWbufferOSMesa));
+}
+
+// Returns the index of the acquired frame held by the specified window, or
+// -1 if it holds none
+// The frame lock must be held
+//
+static int findFrameOSMesa(const _GLFWwindow* window)
+{
+    int i;
+
+    for (i = 0;  i < _glfw.osmesa.frameCount;  i++)
     {
-        int width, height;
-        _glfwPlatformGetFramebufferSize(window, &width, &height);
+        if (_glfw.osmesa.frames[i].window == window)
+            return i;
+    }
+
+    return -1;
+}
+
+// Removes the acquired frame at the specified index
+// The frame lock must be held
+//
+static void removeFrameOSMesa(int index)
+{
+    _glfw.osmesa.frameCount--;
+    memmove(_glfw.osmesa.frames + index,
+            _glfw.osmesa.frames + index + 1,
+            (_glfw.osmesa.frameCount - index) * sizeof(_GLFWframeOSMesa));
+}
+
+// Translates a GLFW color buffer format to OSMesa, or returns zero if the
+// format is invalid
+//
+static int translateFormatOSMesa(int format)
+{
+    if (format == GLFW_OSMESA_RGBA)
+        return OSMESA_RGBA;
+    else if (format == GLFW_OSMESA_BGRA)
+        return OSMESA_BGRA;
+    else if (format == GLFW_OSMESA_RGB_565)
+        return OSMESA_RGB_565;
+    else
+        return 0;
+}
+
+// Translates an OSMesa color buffer format to GLFW
+//
+static int getPublicFormatOSMesa(int format)
+{
+    if (format == OSMESA_RGBA)
+        return GLFW_OSMESA_RGBA;
+    else if (format == OSMESA_BGRA)
+        return GLFW_OSMESA_BGRA;
+    else if (format == OSMESA_RGB_565)
+        return GLFW_OSMESA_RGB_565;
+    else
+        return 0;
+}
+
+// Returns the size in bytes of a pixel in the specified OSMesa format
+//
+static int getBytesPerPixelOSMesa(int format)
+{
+    if (format == OSMESA_RGB_565)
+        return 2;
+    else
+        return 4;
+}
+
+// Returns the OpenGL pixel type matching the specified OSMesa format
+//
+static GLenum getPixelTypeOSMesa(int format)
+{
+    if (format == OSMESA_RGB_565)
+        return GL_UNSIGNED_SHORT_5_6_5;
+    else
+        return GL_UNSIGNED_BYTE;
+}
+
+// Makes the context current with the application provided color buffer
+//
+static GLFWbool makeUserBufferCurrentOSMesa(_GLFWwindow* window)
+{
+    int i;
+    _GLFWcontextOSMesa* context = &window->context.osmesa;
+
+    if (!OSMesaMakeCurrent(context->handle,
+                           context->user.data,
+                           getPixelTypeOSMesa(context->format),
+                           context->user.width,
+                           context->user.height))
+    {
+        return GLFW_FALSE;
+    }
+
+    if (OSMesaPixelStore)
+    {
+        OSMesaPixelStore(OSMESA_ROW_LENGTH,
+                         context->user.stride / getBytesPerPixelOSMesa(context->format));
+    }
+
+    // The internal buffers are not needed while the user buffer is bound,
+    // except for a frame still held by the consumer
+    _glfwPlatformLockMutex(_glfw.osmesa.frameLock);
 
-        // Check to see if we need to allocate a new buffer
-        if ((window->context.osmesa.buffer == NULL) ||
-            (width != window->context.osmesa.width) ||
-            (height != window->context.osmesa.height))
+    for (i = 0;  i < context->count;  i++)
+    {
+        if (i != context->acquired)
+            releaseBufferOSMesa(context->buffers + i);
+    }
+
+    if (context->front != context->acquired)
+    {
+        context->front = -1;
+        context->pending = GLFW_FALSE;
+    }
+
+    _glfwPlatformUnlockMutex(_glfw.osmesa.frameLock);
+
+    return GLFW_TRUE;
+}
+
+// Makes the context current with the back buffer of its swap chain
+//
+static GLFWbool makeInternalBufferCurrentOSMesa(_GLFWwindow* window)
+{
+    int width, height;
+    _GLFWcontextOSMesa* context = &window->context.osmesa;
+    _GLFWbufferOSMesa* buffer = context->buffers + context->back;
+    const _GLFWbufferOSMesa previous = *buffer;
+
+    _glfwPlatformGetFramebufferSize(window, &width, &height);
+
+    // Check to see if we need to allocate a new buffer
+    if ((buffer->data == NULL) ||
+        (width != buffer->width) ||
+        (height != buffer->height))
+    {
+        // Retrieve the new buffer (width * height * bytes per pixel)
+        if (!acquireBufferOSMesa(buffer,
+                                 (size_t) width * height *
+                                 getBytesPerPixelOSMesa(context->format)))
         {
-            free(window->context.osmesa.buffer);
+            *buffer = previous;
+            return GLFW_FALSE;
+        }
 
-            // Allocate the new buffer (width * height * 8-bit RGBA)
-            window->context.osmesa.buffer = calloc(4, width * height);
-            window->context.osmesa.width  = width;
-            window->context.osmesa.height = height;
+        buffer->width  = width;
+        buffer->height = height;
+    }
+
+    if (!OSMesaMakeCurrent(context->handle,
+                           buffer->data,
+                           getPixelTypeOSMesa(context->format),
+                           width, height))
+    {
+        if (buffer->data != previous.data)
+        {
+            releaseBufferOSMesa(buffer);
+            *buffer = previous;
         }
 
-        if (!OSMesaMakeCurrent(window->context.osmesa.handle,
-                               window->context.osmesa.buffer,
-                               GL_UNSIGNED_BYTE,
-                               width, height))
+        return GLFW_FALSE;
+    }
+
+    // Undo any row length set for a previously bound user buffer
+    if (OSMesaPixelStore)
+        OSMesaPixelStore(OSMESA_ROW_LENGTH, 0);
+
+    // The previous buffer is no longer used by the context
+    // The back buffer is never the front or acquired frame, so this cannot
+    // free memory the consumer is reading
+    if (buffer->data != previous.data)
+    {
+        _GLFWbufferOSMesa unused = previous;
+        releaseBufferOSMesa(&unused);
+    }
+
+    return GLFW_TRUE;
+}
+
+static void makeContextCurrentOSMesa(_GLFWwindow* window)
+{
+    if (window)
+    {
+        GLFWbool result;
+
+        if (window->context.osmesa.user.data)
+            result = makeUserBufferCurrentOSMesa(window);
+        else
+            result = makeInternalBufferCurrentOSMesa(window);
+
+        if (!result)
         {
             _glfwInputError(GLFW_PLATFORM_ERROR,
                             "OSMesa: Failed to make context current");
@@ -73,23 +418,92 @@ static GLFWglproc getProcAddressOSMesa(const char* procname)
 
 static void destroyContextOSMesa(_GLFWwindow* window)
 {
-    if (window->context.osmesa.handle)
+    int i, frame;
+    _GLFWcontextOSMesa* context = &window->context.osmesa;
+
+    if (context->handle)
     {
-        OSMesaDestroyContext(window->context.osmesa.handle);
-        window->context.osmesa.handle = NULL;
+        OSMesaDestroyContext(context->handle);
+        context->handle = NULL;
     }
 
-    if (window->context.osmesa.buffer)
+    _glfwPlatformLockMutex(_glfw.osmesa.frameLock);
+
+    // The consumer may still be reading the acquired frame, so its buffer is
+    // kept until the frame is released
+    frame = findFrameOSMesa(window);
+    if (frame != -1)
     {
-        free(window->context.osmesa.buffer);
-        window->context.osmesa.width = 0;
-        window->context.osmesa.height = 0;
+        _glfw.osmesa.frames[frame].window = NULL;
+        _glfw.osmesa.frames[frame].buffer = context->buffers[context->acquired];
+        memset(context->buffers + context->acquired, 0,
+               sizeof(_GLFWbufferOSMesa));
     }
+
+    context->front = -1;
+    context->acquired = -1;
+    context->pending = GLFW_FALSE;
+
+    _glfwPlatformUnlockMutex(_glfw.osmesa.frameLock);
+
+    for (i = 0;  i < context->count;  i++)
+        releaseBufferOSMesa(context->buffers + i);
 }
 
 static void swapBuffersOSMesa(_GLFWwindow* window)
 {
-    // No double buffering on OSMesa
+    int i, next = -1;
+    _GLFWcontextOSMesa* context = &window->context.osmesa;
+    const GLFWbool current =
+        _glfwPlatformGetTls(&_glfw.contextSlot) == window;
+
+    // The frame must be complete before the consumer may read it
+    if (current && context->Finish)
+        context->Finish();
+
+    // There is nothing to swap with a single buffer or a user buffer
+    if (context->count < 2 || context->user.data)
+        return;
+
+    if (!current)
+    {
+        _glfwInputError(GLFW_NO_CURRENT_CONTEXT,
+                        "OSMesa: Cannot swap buffers of a context that is not current on the calling thread");
+        return;
+    }
+
+    _glfwPlatformLockMutex(_glfw.osmesa.frameLock);
+
+    // Rotate to the next buffer not held by the consumer
+    for (i = 1;  i < context->count;  i++)
+    {
+        const int index = (context->back + i) % context->count;
+        if (index != context->acquired)
+        {
+            next = index;
+            break;
+        }
+    }
+
+    // If the consumer holds the only other buffer, the finished frame is
+    // dropped and the next frame is rendered over it
+    if (next != -1)
+    {
+        context->front = context->back;
+        context->back = next;
+        context->pending = GLFW_TRUE;
+    }
+
+    _glfwPlatformUnlockMutex(_glfw.osmesa.frameLock);
+
+    if (next != -1)
+    {
+        if (!makeInternalBufferCurrentOSMesa(window))
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "OSMesa: Failed to swap buffers");
+        }
+    }
 }
 
 static void swapIntervalOSMesa(int interval)
@@ -157,6 +571,8 @@ GLFWbool _glfwInitOSMesa(void)
         _glfw_dlsym(_glfw.osmesa.handle, "OSMesaGetDepthBuffer");
     _glfw.osmesa.GetProcAddress = (PFN_OSMesaGetProcAddress)
         _glfw_dlsym(_glfw.osmesa.handle, "OSMesaGetProcAddress");
+    _glfw.osmesa.PixelStore = (PFN_OSMesaPixelStore)
+        _glfw_dlsym(_glfw.osmesa.handle, "OSMesaPixelStore");
 
     if (!_glfw.osmesa.CreateContextExt ||
         !_glfw.osmesa.DestroyContext ||
@@ -172,11 +588,62 @@ GLFWbool _glfwInitOSMesa(void)
         return GLFW_FALSE;
     }
 
+    _glfw.osmesa.pool.lock = calloc(1, sizeof(_GLFWmutex));
+    if (!_glfwPlatformCreateMutex(_glfw.osmesa.pool.lock))
+    {
+        free(_glfw.osmesa.pool.lock);
+        _glfw.osmesa.pool.lock = NULL;
+
+        _glfwTerminateOSMesa();
+        return GLFW_FALSE;
+    }
+
+    _glfw.osmesa.frameLock = calloc(1, sizeof(_GLFWmutex));
+    if (!_glfwPlatformCreateMutex(_glfw.osmesa.frameLock))
+    {
+        free(_glfw.osmesa.frameLock);
+        _glfw.osmesa.frameLock = NULL;
+
+        _glfwTerminateOSMesa();
+        return GLFW_FALSE;
+    }
+
     return GLFW_TRUE;
 }
 
 void _glfwTerminateOSMesa(void)
 {
+    int i;
+
+    // All windows have been destroyed, so any frame left is held by the consumer
+    for (i = 0;  i < _glfw.osmesa.frameCount;  i++)
+        freeBufferOSMesa(&_glfw.osmesa.frames[i].buffer);
+
+    free(_glfw.osmesa.frames);
+    _glfw.osmesa.frames = NULL;
+    _glfw.osmesa.frameCount = 0;
+
+    while (_glfw.osmesa.pool.count)
+    {
+        _GLFWbufferOSMesa buffer;
+        removeBufferOSMesa(0, &buffer);
+        freeBufferOSMesa(&buffer);
+    }
+
+    if (_glfw.osmesa.pool.lock)
+    {
+        _glfwPlatformDestroyMutex(_glfw.osmesa.pool.lock);
+        free(_glfw.osmesa.pool.lock);
+        _glfw.osmesa.pool.lock = NULL;
+    }
+
+    if (_glfw.osmesa.frameLock)
+    {
+        _glfwPlatformDestroyMutex(_glfw.osmesa.frameLock);
+        free(_glfw.osmesa.frameLock);
+        _glfw.osmesa.frameLock = NULL;
+    }
+
     if (_glfw.osmesa.handle)
     {
         _glfw_dlclose(_glfw.osmesa.handle);
@@ -195,6 +662,7 @@ GLFWbool _glfwCreateContextOSMesa(_GLFWwindow* window,
                                   const _GLFWctxconfig* ctxconfig,
                                   const _GLFWfbconfig* fbconfig)
 {
+    int format;
     OSMesaContext share = NULL;
     const int accumBits = fbconfig->accumRedBits +
                           fbconfig->accumGreenBits +
@@ -208,6 +676,24 @@ GLFWbool _glfwCreateContextOSMesa(_GLFWwindow* window,
         return GLFW_FALSE;
     }
 
+    format = translateFormatOSMesa(ctxconfig->osmesa.format);
+    if (!format)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM,
+                        "OSMesa: Invalid color buffer format 0x%08X",
+                        ctxconfig->osmesa.format);
+        return GLFW_FALSE;
+    }
+
+    if (ctxconfig->osmesa.buffers < 1 ||
+        ctxconfig->osmesa.buffers > _GLFW_OSMESA_MAX_BUFFERS)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "OSMesa: Invalid color buffer count %i",
+                        ctxconfig->osmesa.buffers);
+        return GLFW_FALSE;
+    }
+
     if (ctxconfig->share)
         share = ctxconfig->share->context.osmesa.handle;
 
@@ -215,7 +701,7 @@ GLFWbool _glfwCreateContextOSMesa(_GLFWwindow* window,
     {
         int index = 0, attribs[40];
 
-        setAttrib(OSMESA_FORMAT, OSMESA_RGBA);
+        setAttrib(OSMESA_FORMAT, format);
         setAttrib(OSMESA_DEPTH_BITS, fbconfig->depthBits);
         setAttrib(OSMESA_STENCIL_BITS, fbconfig->stencilBits);
         setAttrib(OSMESA_ACCUM_BITS, accumBits);
@@ -257,7 +743,7 @@ GLFWbool _glfwCreateContextOSMesa(_GLFWwindow* window,
         }
 
         window->context.osmesa.handle =
-            OSMesaCreateContextExt(OSMESA_RGBA,
+            OSMesaCreateContextExt(format,
                                    fbconfig->depthBits,
                                    fbconfig->stencilBits,
                                    accumBits,
@@ -271,6 +757,15 @@ GLFWbool _glfwCreateContextOSMesa(_GLFWwindow* window,
         return GLFW_FALSE;
     }
 
+    window->context.osmesa.format = format;
+    window->context.osmesa.count = ctxconfig->osmesa.buffers;
+    window->context.osmesa.back = 0;
+    window->context.osmesa.front = -1;
+    window->context.osmesa.acquired = -1;
+    window->context.osmesa.pending = GLFW_FALSE;
+    window->context.osmesa.Finish = (PFNGLFINISHPROC)
+        OSMesaGetProcAddress("glFinish");
+
     window->context.makeCurrent = makeContextCurrentOSMesa;
     window->context.swapBuffers = swapBuffersOSMesa;
     window->context.swapInterval = swapIntervalOSMesa;
@@ -312,13 +807,229 @@ GLFWAPI int glfwGetOSMesaColorBuffer(GLFWwindow* handle, int* width,
     if (height)
         *height = mesaHeight;
     if (format)
-        *format = mesaFormat;
+        *format = getPublicFormatOSMesa(mesaFormat);
     if (buffer)
         *buffer = mesaBuffer;
 
     return GLFW_TRUE;
 }
 
+GLFWAPI int glfwSetOSMesaColorBuffer(GLFWwindow* handle, void* buffer,
+                                     int width, int height, int stride,
+                                     int format)
+{
+    _GLFWcontextOSMesa* context;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(width >= 0);
+    assert(height >= 0);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    context = &window->context.osmesa;
+
+    if (window->context.client == GLFW_NO_API || !context->handle)
+    {
+        _glfwInputError(GLFW_NO_WINDOW_CONTEXT,
+                        "OSMesa: Window does not have an OSMesa context");
+        return GLFW_FALSE;
+    }
+
+    if (buffer)
+    {
+        int bytesPerPixel;
+        const int mesaFormat = translateFormatOSMesa(format);
+
+        if (!mesaFormat)
+        {
+            _glfwInputError(GLFW_INVALID_ENUM,
+                            "OSMesa: Invalid color buffer format 0x%08X",
+                            format);
+            return GLFW_FALSE;
+        }
+
+        if (mesaFormat != context->format)
+        {
+            _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                            "OSMesa: Color buffer format does not match the context");
+            return GLFW_FALSE;
+        }
+
+        bytesPerPixel = getBytesPerPixelOSMesa(context->format);
+
+        if (width <= 0 || height <= 0)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "OSMesa: Invalid color buffer size %ix%i",
+                            width, height);
+            return GLFW_FALSE;
+        }
+
+        if (stride == 0)
+            stride = width * bytesPerPixel;
+
+        if (stride < width * bytesPerPixel || stride % bytesPerPixel)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "OSMesa: Invalid color buffer stride %i", stride);
+            return GLFW_FALSE;
+        }
+
+        if (stride != width * bytesPerPixel && !OSMesaPixelStore)
+        {
+            _glfwInputError(GLFW_API_UNAVAILABLE,
+                            "OSMesa: Library does not support row lengths");
+            return GLFW_FALSE;
+        }
+    }
+
+    context->user.data = buffer;
+    context->user.width = width;
+    context->user.height = height;
+    context->user.stride = stride;
+
+    // Rebind immediately if the context is current on the calling thread,
+    // otherwise the buffer is bound the next time the context is made current
+    if (_glfwPlatformGetTls(&_glfw.contextSlot) == window)
+        makeContextCurrentOSMesa(window);
+
+    return GLFW_TRUE;
+}
+
+GLFWAPI int glfwAcquireOSMesaFrame(GLFWwindow* handle, int* width,
+                                   int* height, int* format, void** buffer)
+{
+    int index, id = 0, slot;
+    _GLFWbufferOSMesa frame;
+    _GLFWcontextOSMesa* context;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (width)
+        *width = 0;
+    if (height)
+        *height = 0;
+    if (format)
+        *format = 0;
+    if (buffer)
+        *buffer = NULL;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    context = &window->context.osmesa;
+
+    if (window->context.client == GLFW_NO_API || !context->handle)
+    {
+        _glfwInputError(GLFW_NO_WINDOW_CONTEXT,
+                        "OSMesa: Window does not have an OSMesa context");
+        return 0;
+    }
+
+    if (context->count < 2)
+    {
+        _glfwInputError(GLFW_API_UNAVAILABLE,
+                        "OSMesa: Acquiring frames requires at least two color buffers");
+        return 0;
+    }
+
+    _glfwPlatformLockMutex(_glfw.osmesa.frameLock);
+
+    // Acquiring a frame releases any previously acquired frame, but a frame
+    // that has already been acquired is not held again, as that would keep the
+    // swap chain from publishing newer frames
+    slot = findFrameOSMesa(window);
+    if (context->pending)
+    {
+        if (slot == -1)
+        {
+            _GLFWframeOSMesa* frames =
+                realloc(_glfw.osmesa.frames,
+                        (_glfw.osmesa.frameCount + 1) * sizeof(_GLFWframeOSMesa));
+            if (!frames)
+            {
+                _glfwPlatformUnlockMutex(_glfw.osmesa.frameLock);
+                _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+                return 0;
+            }
+
+            slot = _glfw.osmesa.frameCount++;
+            _glfw.osmesa.frames = frames;
+            memset(frames + slot, 0, sizeof(_GLFWframeOSMesa));
+            frames[slot].window = window;
+        }
+
+        // Frames get new IDs so that a stale ID never releases a later frame
+        _glfw.osmesa.frameSerial = _glfw.osmesa.frameSerial % INT_MAX + 1;
+        id = _glfw.osmesa.frames[slot].id = _glfw.osmesa.frameSerial;
+
+        index = context->acquired = context->front;
+        frame = context->buffers[index];
+        context->pending = GLFW_FALSE;
+    }
+    else
+    {
+        if (slot != -1)
+            removeFrameOSMesa(slot);
+
+        index = context->acquired = -1;
+    }
+
+    _glfwPlatformUnlockMutex(_glfw.osmesa.frameLock);
+
+    // No frame has been completed since the last one was acquired
+    if (index == -1)
+        return 0;
+
+    if (width)
+        *width = frame.width;
+    if (height)
+        *height = frame.height;
+    if (format)
+        *format = getPublicFormatOSMesa(context->format);
+    if (buffer)
+        *buffer = frame.data;
+
+    return id;
+}
+
+GLFWAPI void glfwReleaseOSMesaFrame(int id)
+{
+    int i;
+    _GLFWbufferOSMesa unused;
+
+    _GLFW_REQUIRE_INIT();
+
+    // Frames are only acquired once a context has initialized OSMesa
+    if (!_glfw.osmesa.frameLock)
+        return;
+
+    memset(&unused, 0, sizeof(unused));
+
+    _glfwPlatformLockMutex(_glfw.osmesa.frameLock);
+
+    // The window of the frame may have been destroyed, so it is only reached
+    // through the frame list, which never refers to a destroyed window
+    for (i = 0;  i < _glfw.osmesa.frameCount;  i++)
+    {
+        _GLFWframeOSMesa* frame = _glfw.osmesa.frames + i;
+        if (frame->id != id)
+            continue;
+
+        if (frame->window)
+            frame->window->context.osmesa.acquired = -1;
+        else
+            unused = frame->buffer;
+
+        removeFrameOSMesa(i);
+        break;
+    }
+
+    _glfwPlatformUnlockMutex(_glfw.osmesa.frameLock);
+
+    if (unused.data)
+        releaseBufferOSMesa(&unused);
+}
+
 GLFWAPI int glfwGetOSMesaDepthBuffer(GLFWwindow* handle,
                                      int* width, int* height,
                                      int* bytesPerValue,
@@ -26,6 +26,8 @@
 //========================================================================
 
 #define OSMESA_RGBA 0x1908
+#define OSMESA_BGRA 0x1
+#define OSMESA_RGB_565 0x5
 #define OSMESA_FORMAT 0x22
 #define OSMESA_DEPTH_BITS 0x30
 #define OSMESA_STENCIL_BITS 0x31
@@ -35,6 +37,9 @@
 #define OSMESA_COMPAT_PROFILE 0x35
 #define OSMESA_CONTEXT_MAJOR_VERSION 0x36
 #define OSMESA_CONTEXT_MINOR_VERSION 0x37
+#define OSMESA_ROW_LENGTH 0x10
+
+#define GL_UNSIGNED_SHORT_5_6_5 0x8363
 
 typedef void* OSMesaContext;
 typedef void (*OSMESAproc)();
@@ -46,6 +51,7 @@ typedef int (GLAPIENTRY * PFN_OSMesaMakeCurrent)(OSMesaContext,void*,int,int,int
 typedef int (GLAPIENTRY * PFN_OSMesaGetColorBuffer)(OSMesaContext,int*,int*,int*,void**);
 typedef int (GLAPIENTRY * PFN_OSMesaGetDepthBuffer)(OSMesaContext,int*,int*,int*,void**);
 typedef GLFWglproc (GLAPIENTRY * PFN_OSMesaGetProcAddress)(const char*);
+typedef void (GLAPIENTRY * PFN_OSMesaPixelStore)(GLint,GLint);
 #define OSMesaCreateContextExt _glfw.osmesa.CreateContextExt
 #define OSMesaCreateContextAttribs _glfw.osmesa.CreateContextAttribs
 #define OSMesaDestroyContext _glfw.osmesa.DestroyContext
@@ -53,19 +59,71 @@ typedef GLFWglproc (GLAPIENTRY * PFN_OSMesaGetProcAddress)(const char*);
 #define OSMesaGetColorBuffer _glfw.osmesa.GetColorBuffer
 #define OSMesaGetDepthBuffer _glfw.osmesa.GetDepthBuffer
 #define OSMesaGetProcAddress _glfw.osmesa.GetProcAddress
+#define OSMesaPixelStore _glfw.osmesa.PixelStore
 
 #define _GLFW_OSMESA_CONTEXT_STATE              _GLFWcontextOSMesa osmesa
 #define _GLFW_OSMESA_LIBRARY_CONTEXT_STATE      _GLFWlibraryOSMesa osmesa
 
+// The maximum number of released color buffers kept for reuse
+#define _GLFW_OSMESA_POOL_CAPACITY 16
+// The maximum number of color buffers in the swap chain of a context
+#define _GLFW_OSMESA_MAX_BUFFERS 3
+
+
+// OSMesa color buffer allocation
+//
+typedef struct _GLFWbufferOSMesa
+{
+    void*               data;
+    // Length of the allocation, which huge pages may round up
+    size_t              size;
+    // Size of the pool bucket the buffer was allocated for
+    size_t              bucket;
+    GLFWbool            mapped;
+    int                 width;
+    int                 height;
+
+} _GLFWbufferOSMesa;
+
+// Frame held by the consumer, kept until it is released by its ID
+//
+typedef struct _GLFWframeOSMesa
+{
+    int                 id;
+    // Window whose swap chain holds the frame, or NULL if it was destroyed
+    _GLFWwindow*        window;
+    // Buffer of the frame once its window has been destroyed
+    _GLFWbufferOSMesa   buffer;
+
+} _GLFWframeOSMesa;
 
 // OSMesa-specific per-context data
 //
 typedef struct _GLFWcontextOSMesa
 {
     OSMesaContext       handle;
-    int                 width;
-    int                 height;
-    void*               buffer;
+    int                 format;
+    PFNGLFINISHPROC     Finish;
+
+    // Swap chain of internal color buffers
+    _GLFWbufferOSMesa   buffers[_GLFW_OSMESA_MAX_BUFFERS];
+    int                 count;
+    // Index of the buffer being rendered to
+    int                 back;
+    // Index of the most recently completed frame, or -1 if none
+    int                 front;
+    // Index of the frame held by glfwAcquireOSMesaFrame, or -1 if none
+    int                 acquired;
+    // Whether the front frame has been completed since the last acquisition
+    GLFWbool            pending;
+
+    // Color buffer provided by the application, if any
+    struct {
+        void*           data;
+        int             width;
+        int             height;
+        int             stride;
+    } user;
 
 } _GLFWcontextOSMesa;
 
@@ -82,6 +140,23 @@ typedef struct _GLFWlibraryOSMesa
     PFN_OSMesaGetColorBuffer        GetColorBuffer;
     PFN_OSMesaGetDepthBuffer        GetDepthBuffer;
     PFN_OSMesaGetProcAddress        GetProcAddress;
+    PFN_OSMesaPixelStore            PixelStore;
+
+    // Protects the front and acquired frames of all swap chains
+    _GLFWmutex*     frameLock;
+    // Acquired frames of all windows, also protected by the frame lock
+    _GLFWframeOSMesa*   frames;
+    int                 frameCount;
+    // ID of the most recently acquired frame
+    int                 frameSerial;
+
+    // Color buffers released by contexts, shared by all windows
+    struct {
+        _GLFWmutex*         lock;
+        _GLFWbufferOSMesa   buffers[_GLFW_OSMESA_POOL_CAPACITY];
+        int                 count;
+        size_t              size;
+    } pool;
 
 } _GLFWlibraryOSMesa;
 
@@ -0,0 +1,219 @@
+//========================================================================
+// GLFW 3.3 - www.glfw.org
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2016 Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+#include "internal.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define _GLFW_PIXEL_SSE2
+ #include <emmintrin.h>
+#elif defined(__ARM_NEON) && !defined(__ARM_BIG_ENDIAN)
+ #define _GLFW_PIXEL_NEON
+ #include <arm_neon.h>
+#endif
+
+// The number of pixels converted at a time when widening to long
+//
+#define _GLFW_PIXEL_BLOCK_SIZE 256
+
+
+// Converts RGBA pixels to ARGB one pixel at a time
+//
+static void convertToARGB(uint32_t* target,
+                          const unsigned char* source,
+                          size_t count)
+{
+    size_t i;
+
+    for (i = 0;  i < count;  i++, source += 4)
+    {
+        target[i] = ((uint32_t) source[3] << 24) |
+                    ((uint32_t) source[0] << 16) |
+                    ((uint32_t) source[1] <<  8) |
+                    ((uint32_t) source[2] <<  0);
+    }
+}
+
+// Converts RGBA pixels to premultiplied ARGB one pixel at a time
+//
+static void convertToPremultipliedARGB(uint32_t* target,
+                                       const unsigned char* source,
+                                       size_t count)
+{
+    size_t i;
+
+    for (i = 0;  i < count;  i++, source += 4)
+    {
+        const unsigned int alpha = source[3];
+
+        target[i] = ((uint32_t) alpha << 24) |
+                    ((uint32_t) ((source[0] * alpha) / 255) << 16) |
+                    ((uint32_t) ((source[1] * alpha) / 255) <<  8) |
+                    ((uint32_t) ((source[2] * alpha) / 255) <<  0);
+    }
+}
+
+#if defined(_GLFW_PIXEL_SSE2)
+
+// Divides eight 16-bit products of two bytes by 255, rounding down
+//
+static __m128i divideBy255(__m128i x)
+{
+    // NOTE: (x + 1 + (x >> 8)) >> 8 equals x / 255 for all x <= 255 * 255
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)),
+                                        _mm_srli_epi16(x, 8)), 8);
+}
+
+// Premultiplies two RGBA pixels widened to 16 bits and reorders them as BGRA
+//
+static __m128i premultiplyPixels(__m128i pixels)
+{
+    const __m128i mask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    __m128i alpha, color;
+
+    alpha = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+    color = divideBy255(_mm_mullo_epi16(pixels, alpha));
+    color = _mm_or_si128(_mm_andnot_si128(mask, color),
+                         _mm_and_si128(mask, pixels));
+    color = _mm_shufflelo_epi16(color, _MM_SHUFFLE(3, 0, 1, 2));
+    return _mm_shufflehi_epi16(color, _MM_SHUFFLE(3, 0, 1, 2));
+}
+
+#endif // _GLFW_PIXEL_SSE2
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+void _glfwConvertToARGB(uint32_t* target,
+                        const unsigned char* source,
+                        size_t count)
+{
+    size_t i = 0;
+
+#if defined(_GLFW_PIXEL_SSE2)
+    const __m128i mask = _mm_set1_epi32((int) 0xff00ff00);
+    const __m128i low = _mm_set1_epi32(0x000000ff);
+
+    for (;  i + 4 <= count;  i += 4)
+    {
+        const __m128i pixels =
+            _mm_loadu_si128((const __m128i*) (source + i * 4));
+
+        _mm_storeu_si128((__m128i*) (target + i),
+            _mm_or_si128(_mm_and_si128(pixels, mask),
+                _mm_or_si128(_mm_slli_epi32(_mm_and_si128(pixels, low), 16),
+                             _mm_and_si128(_mm_srli_epi32(pixels, 16), low))));
+    }
+#elif defined(_GLFW_PIXEL_NEON)
+    for (;  i + 16 <= count;  i += 16)
+    {
+        const uint8x16x4_t pixels = vld4q_u8(source + i * 4);
+        uint8x16x4_t result;
+
+        result.val[0] = pixels.val[2];
+        result.val[1] = pixels.val[1];
+        result.val[2] = pixels.val[0];
+        result.val[3] = pixels.val[3];
+        vst4q_u8((uint8_t*) (target + i), result);
+    }
+#endif
+
+    convertToARGB(target + i, source + i * 4, count - i);
+}
+
+void _glfwConvertToPremultipliedARGB(uint32_t* target,
+                                     const unsigned char* source,
+                                     size_t count)
+{
+    size_t i = 0;
+
+#if defined(_GLFW_PIXEL_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+
+    for (;  i + 4 <= count;  i += 4)
+    {
+        const __m128i pixels =
+            _mm_loadu_si128((const __m128i*) (source + i * 4));
+
+        _mm_storeu_si128((__m128i*) (target + i),
+            _mm_packus_epi16(
+                premultiplyPixels(_mm_unpacklo_epi8(pixels, zero)),
+                premultiplyPixels(_mm_unpackhi_epi8(pixels, zero))));
+    }
+#elif defined(_GLFW_PIXEL_NEON)
+    const uint16x8_t one = vdupq_n_u16(1);
+
+    for (;  i + 8 <= count;  i += 8)
+    {
+        const uint8x8x4_t pixels = vld4_u8(source + i * 4);
+        uint8x8x4_t result;
+        int j;
+
+        for (j = 0;  j < 3;  j++)
+        {
+            // NOTE: (x + 1 + (x >> 8)) >> 8 equals x / 255 for all x <= 255 * 255
+            const uint16x8_t x = vmull_u8(pixels.val[j], pixels.val[3]);
+            result.val[2 - j] =
+                vshrn_n_u16(vaddq_u16(vaddq_u16(x, one), vshrq_n_u16(x, 8)), 8);
+        }
+
+        result.val[3] = pixels.val[3];
+        vst4_u8((uint8_t*) (target + i), result);
+    }
+#endif
+
+    convertToPremultipliedARGB(target + i, source + i * 4, count - i);
+}
+
+void _glfwConvertToARGBLong(long* target,
+                            const unsigned char* source,
+                            size_t count)
+{
+    if (sizeof(long) == sizeof(uint32_t))
+        _glfwConvertToARGB((uint32_t*) target, source, count);
+    else
+    {
+        uint32_t block[_GLFW_PIXEL_BLOCK_SIZE];
+        size_t i, j;
+
+        for (i = 0;  i < count;  i += j)
+        {
+            size_t size = count - i;
+            if (size > _GLFW_PIXEL_BLOCK_SIZE)
+                size = _GLFW_PIXEL_BLOCK_SIZE;
+
+            _glfwConvertToARGB(block, source + i * 4, size);
+
+            for (j = 0;  j < size;  j++)
+                target[i + j] = (long) block[j];
+        }
+    }
+}
+
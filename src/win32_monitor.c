@@ -402,7 +402,7 @@ void _glfwPlatformGetGammaRamp(_GLFWmonitor* monitor, GLFWgammaramp* ramp)
     memcpy(ramp->blue,  values + 512, 256 * sizeof(unsigned short));
 }
 
-void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
+GLFWbool _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
 {
     HDC dc;
     WORD values[768];
@@ -411,7 +411,7 @@ void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
                         "Win32: Gamma ramp size must be 256");
-        return;
+        return GLFW_FALSE;
     }
 
     memcpy(values +   0, ramp->red,   256 * sizeof(unsigned short));
@@ -421,6 +421,7 @@ void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
     dc = CreateDCW(L"DISPLAY", monitor->win32.adapterName, NULL, NULL);
     SetDeviceGammaRamp(dc, values);
     DeleteDC(dc);
+    return GLFW_TRUE;
 }
 
 
@@ -101,14 +101,12 @@ static const GLFWimage* chooseImage(int count, const GLFWimage* images,
 static HICON createIcon(const GLFWimage* image,
                         int xhot, int yhot, GLFWbool icon)
 {
-    int i;
     HDC dc;
     HICON handle;
     HBITMAP color, mask;
     BITMAPV5HEADER bi;
     ICONINFO ii;
     unsigned char* target = NULL;
-    unsigned char* source = image->pixels;
 
     ZeroMemory(&bi, sizeof(bi));
     bi.bV5Size        = sizeof(BITMAPV5HEADER);
@@ -147,15 +145,8 @@ static HICON createIcon(const GLFWimage* image,
         return NULL;
     }
 
-    for (i = 0;  i < image->width * image->height;  i++)
-    {
-        target[0] = source[2];
-        target[1] = source[1];
-        target[2] = source[0];
-        target[3] = source[3];
-        target += 4;
-        source += 4;
-    }
+    _glfwConvertToARGB((uint32_t*) target, image->pixels,
+                       image->width * image->height);
 
     ZeroMemory(&ii, sizeof(ii));
     ii.fIcon    = icon;
@@ -1609,6 +1600,15 @@ void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode)
         updateCursorImage(window);
 }
 
+GLFWbool _glfwPlatformRawMouseMotionSupported(void)
+{
+    return GLFW_FALSE;
+}
+
+void _glfwPlatformSetRawMouseMotion(_GLFWwindow* window, GLFWbool enabled)
+{
+}
+
 const char* _glfwPlatformGetKeyName(int key, int scancode)
 {
     WCHAR name[16];
@@ -1649,6 +1649,16 @@ int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
     return GLFW_TRUE;
 }
 
+int _glfwPlatformCreateAnimatedCursor(_GLFWcursor* cursor,
+                                      const GLFWimage* frames,
+                                      const int* delays,
+                                      int count,
+                                      int xhot, int yhot)
+{
+    // TODO: Implement animated cursors
+    return _glfwPlatformCreateCursor(cursor, frames, xhot, yhot);
+}
+
 int _glfwPlatformCreateStandardCursor(_GLFWcursor* cursor, int shape)
 {
     cursor->win32.handle =
@@ -1757,6 +1767,33 @@ const char* _glfwPlatformGetClipboardString(_GLFWwindow* window)
     return _glfw.win32.clipboardString;
 }
 
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window)
+{
+    _glfwInputClipboardString(_glfwPlatformGetClipboardString(window));
+}
+
+void _glfwPlatformSetClipboardData(_GLFWwindow* window)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Win32: Typed clipboard data not implemented yet");
+}
+
+const char** _glfwPlatformGetClipboardTypes(_GLFWwindow* window, int* count)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Win32: Typed clipboard data not implemented yet");
+    return NULL;
+}
+
+const void* _glfwPlatformGetClipboardData(_GLFWwindow* window,
+                                          const char* type,
+                                          size_t* size)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Win32: Typed clipboard data not implemented yet");
+    return NULL;
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface || !_glfw.vk.KHR_win32_surface)
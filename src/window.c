@@ -244,6 +244,10 @@ void glfwDefaultWindowHints(void)
     _glfw.hints.context.major  = 1;
     _glfw.hints.context.minor  = 0;
 
+    // The default is a single 8-bit RGBA color buffer for OSMesa contexts
+    _glfw.hints.context.osmesa.format = GLFW_OSMESA_RGBA;
+    _glfw.hints.context.osmesa.buffers = 1;
+
     // The default is a focused, visible, resizable window with decorations
     memset(&_glfw.hints.window, 0, sizeof(_glfw.hints.window));
     _glfw.hints.window.resizable   = GLFW_TRUE;
@@ -351,6 +355,12 @@ GLFWAPI void glfwWindowHint(int hint, int value)
         case GLFW_COCOA_GRAPHICS_SWITCHING:
             _glfw.hints.context.nsgl.offline = value ? GLFW_TRUE : GLFW_FALSE;
             break;
+        case GLFW_OSMESA_COLOR_FORMAT:
+            _glfw.hints.context.osmesa.format = value;
+            break;
+        case GLFW_OSMESA_BUFFER_COUNT:
+            _glfw.hints.context.osmesa.buffers = value;
+            break;
         case GLFW_CENTER_CURSOR:
             _glfw.hints.window.centerCursor = value ? GLFW_TRUE : GLFW_FALSE;
             break;
@@ -413,6 +423,13 @@ GLFWAPI void glfwDestroyWindow(GLFWwindow* handle)
 
     _glfwPlatformDestroyWindow(window);
 
+    // Clipboard data not yet provided can no longer be provided
+    if (_glfw.clipboard.window == window)
+    {
+        _glfw.clipboard.window = NULL;
+        _glfw.clipboard.provider = NULL;
+    }
+
     // Unlink window from global linked list
     {
         _GLFWwindow** prev = &_glfw.windowListHead;
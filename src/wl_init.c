@@ -693,6 +693,7 @@ int _glfwPlatformInit(void)
 void _glfwPlatformTerminate(void)
 {
     _glfwTerminateEGL();
+    _glfwTerminateOSMesa();
     _glfwTerminateJoysticksLinux();
 
     xkb_compose_state_unref(_glfw.wl.xkb.composeState);
@@ -721,6 +721,15 @@ void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode)
     _glfwPlatformSetCursor(window, window->wl.currentCursor);
 }
 
+GLFWbool _glfwPlatformRawMouseMotionSupported(void)
+{
+    return GLFW_FALSE;
+}
+
+void _glfwPlatformSetRawMouseMotion(_GLFWwindow* window, GLFWbool enabled)
+{
+}
+
 const char* _glfwPlatformGetKeyName(int key, int scancode)
 {
     // TODO
@@ -740,7 +749,7 @@ int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
     int stride = image->width * 4;
     int length = image->width * image->height * 4;
     void* data;
-    int fd, i;
+    int fd;
 
     fd = createAnonymousFile(length);
     if (fd < 0)
@@ -763,17 +772,8 @@ int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
     pool = wl_shm_create_pool(_glfw.wl.shm, fd, length);
 
     close(fd);
-    unsigned char* source = (unsigned char*) image->pixels;
-    unsigned char* target = data;
-    for (i = 0;  i < image->width * image->height;  i++, source += 4)
-    {
-        unsigned int alpha = source[3];
-
-        *target++ = (unsigned char) ((source[2] * alpha) / 255);
-        *target++ = (unsigned char) ((source[1] * alpha) / 255);
-        *target++ = (unsigned char) ((source[0] * alpha) / 255);
-        *target++ = (unsigned char) alpha;
-    }
+    _glfwConvertToPremultipliedARGB(data, image->pixels,
+                                    image->width * image->height);
 
     cursor->wl.buffer =
         wl_shm_pool_create_buffer(pool, 0,
@@ -790,6 +790,16 @@ int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
     return GLFW_TRUE;
 }
 
+int _glfwPlatformCreateAnimatedCursor(_GLFWcursor* cursor,
+                                      const GLFWimage* frames,
+                                      const int* delays,
+                                      int count,
+                                      int xhot, int yhot)
+{
+    // TODO: Implement animated cursors
+    return _glfwPlatformCreateCursor(cursor, frames, xhot, yhot);
+}
+
 int _glfwPlatformCreateStandardCursor(_GLFWcursor* cursor, int shape)
 {
     struct wl_cursor* standardCursor;
@@ -1006,6 +1016,33 @@ const char* _glfwPlatformGetClipboardString(_GLFWwindow* window)
     return NULL;
 }
 
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window)
+{
+    _glfwInputClipboardString(_glfwPlatformGetClipboardString(window));
+}
+
+void _glfwPlatformSetClipboardData(_GLFWwindow* window)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Wayland: Typed clipboard data not implemented yet");
+}
+
+const char** _glfwPlatformGetClipboardTypes(_GLFWwindow* window, int* count)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Wayland: Typed clipboard data not implemented yet");
+    return NULL;
+}
+
+const void* _glfwPlatformGetClipboardData(_GLFWwindow* window,
+                                          const char* type,
+                                          size_t* size)
+{
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Wayland: Typed clipboard data not implemented yet");
+    return NULL;
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface || !_glfw.vk.KHR_wayland_surface)
@@ -32,6 +32,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <assert.h>
 #include <stdio.h>
 #include <locale.h>
 
@@ -226,11 +227,174 @@ static int translateKeyCode(int scancode)
     return GLFW_KEY_UNKNOWN;
 }
 
+// XKB key names of the physical keys, mapped to GLFW keys
+//
+static const struct
+{
+    int key;
+    char name[XkbKeyNameLength];
+} keyNames[] =
+{
+    // Printable keys, using the US keyboard layout
+    { GLFW_KEY_GRAVE_ACCENT, "TLDE" },
+    { GLFW_KEY_1, "AE01" },
+    { GLFW_KEY_2, "AE02" },
+    { GLFW_KEY_3, "AE03" },
+    { GLFW_KEY_4, "AE04" },
+    { GLFW_KEY_5, "AE05" },
+    { GLFW_KEY_6, "AE06" },
+    { GLFW_KEY_7, "AE07" },
+    { GLFW_KEY_8, "AE08" },
+    { GLFW_KEY_9, "AE09" },
+    { GLFW_KEY_0, "AE10" },
+    { GLFW_KEY_MINUS, "AE11" },
+    { GLFW_KEY_EQUAL, "AE12" },
+    { GLFW_KEY_Q, "AD01" },
+    { GLFW_KEY_W, "AD02" },
+    { GLFW_KEY_E, "AD03" },
+    { GLFW_KEY_R, "AD04" },
+    { GLFW_KEY_T, "AD05" },
+    { GLFW_KEY_Y, "AD06" },
+    { GLFW_KEY_U, "AD07" },
+    { GLFW_KEY_I, "AD08" },
+    { GLFW_KEY_O, "AD09" },
+    { GLFW_KEY_P, "AD10" },
+    { GLFW_KEY_LEFT_BRACKET, "AD11" },
+    { GLFW_KEY_RIGHT_BRACKET, "AD12" },
+    { GLFW_KEY_A, "AC01" },
+    { GLFW_KEY_S, "AC02" },
+    { GLFW_KEY_D, "AC03" },
+    { GLFW_KEY_F, "AC04" },
+    { GLFW_KEY_G, "AC05" },
+    { GLFW_KEY_H, "AC06" },
+    { GLFW_KEY_J, "AC07" },
+    { GLFW_KEY_K, "AC08" },
+    { GLFW_KEY_L, "AC09" },
+    { GLFW_KEY_SEMICOLON, "AC10" },
+    { GLFW_KEY_APOSTROPHE, "AC11" },
+    { GLFW_KEY_Z, "AB01" },
+    { GLFW_KEY_X, "AB02" },
+    { GLFW_KEY_C, "AB03" },
+    { GLFW_KEY_V, "AB04" },
+    { GLFW_KEY_B, "AB05" },
+    { GLFW_KEY_N, "AB06" },
+    { GLFW_KEY_M, "AB07" },
+    { GLFW_KEY_COMMA, "AB08" },
+    { GLFW_KEY_PERIOD, "AB09" },
+    { GLFW_KEY_SLASH, "AB10" },
+    { GLFW_KEY_BACKSLASH, "BKSL" },
+    { GLFW_KEY_WORLD_1, "LSGT" },
+
+    // Named keys
+    { GLFW_KEY_SPACE, "SPCE" },
+    { GLFW_KEY_ESCAPE, "ESC" },
+    { GLFW_KEY_ENTER, "RTRN" },
+    { GLFW_KEY_TAB, "TAB" },
+    { GLFW_KEY_BACKSPACE, "BKSP" },
+    { GLFW_KEY_INSERT, "INS" },
+    { GLFW_KEY_DELETE, "DELE" },
+    { GLFW_KEY_RIGHT, "RGHT" },
+    { GLFW_KEY_LEFT, "LEFT" },
+    { GLFW_KEY_DOWN, "DOWN" },
+    { GLFW_KEY_UP, "UP" },
+    { GLFW_KEY_PAGE_UP, "PGUP" },
+    { GLFW_KEY_PAGE_DOWN, "PGDN" },
+    { GLFW_KEY_HOME, "HOME" },
+    { GLFW_KEY_END, "END" },
+    { GLFW_KEY_CAPS_LOCK, "CAPS" },
+    { GLFW_KEY_SCROLL_LOCK, "SCLK" },
+    { GLFW_KEY_NUM_LOCK, "NMLK" },
+    { GLFW_KEY_PRINT_SCREEN, "PRSC" },
+    { GLFW_KEY_PAUSE, "PAUS" },
+
+    // F1 to F25
+    { GLFW_KEY_F1, "FK01" },
+    { GLFW_KEY_F2, "FK02" },
+    { GLFW_KEY_F3, "FK03" },
+    { GLFW_KEY_F4, "FK04" },
+    { GLFW_KEY_F5, "FK05" },
+    { GLFW_KEY_F6, "FK06" },
+    { GLFW_KEY_F7, "FK07" },
+    { GLFW_KEY_F8, "FK08" },
+    { GLFW_KEY_F9, "FK09" },
+    { GLFW_KEY_F10, "FK10" },
+    { GLFW_KEY_F11, "FK11" },
+    { GLFW_KEY_F12, "FK12" },
+    { GLFW_KEY_F13, "FK13" },
+    { GLFW_KEY_F14, "FK14" },
+    { GLFW_KEY_F15, "FK15" },
+    { GLFW_KEY_F16, "FK16" },
+    { GLFW_KEY_F17, "FK17" },
+    { GLFW_KEY_F18, "FK18" },
+    { GLFW_KEY_F19, "FK19" },
+    { GLFW_KEY_F20, "FK20" },
+    { GLFW_KEY_F21, "FK21" },
+    { GLFW_KEY_F22, "FK22" },
+    { GLFW_KEY_F23, "FK23" },
+    { GLFW_KEY_F24, "FK24" },
+    { GLFW_KEY_F25, "FK25" },
+
+    // Keypad keys
+    { GLFW_KEY_KP_0, "KP0" },
+    { GLFW_KEY_KP_1, "KP1" },
+    { GLFW_KEY_KP_2, "KP2" },
+    { GLFW_KEY_KP_3, "KP3" },
+    { GLFW_KEY_KP_4, "KP4" },
+    { GLFW_KEY_KP_5, "KP5" },
+    { GLFW_KEY_KP_6, "KP6" },
+    { GLFW_KEY_KP_7, "KP7" },
+    { GLFW_KEY_KP_8, "KP8" },
+    { GLFW_KEY_KP_9, "KP9" },
+    { GLFW_KEY_KP_DECIMAL, "KPDL" },
+    { GLFW_KEY_KP_DIVIDE, "KPDV" },
+    { GLFW_KEY_KP_MULTIPLY, "KPMU" },
+    { GLFW_KEY_KP_SUBTRACT, "KPSU" },
+    { GLFW_KEY_KP_ADD, "KPAD" },
+    { GLFW_KEY_KP_ENTER, "KPEN" },
+    { GLFW_KEY_KP_EQUAL, "KPEQ" },
+
+    // Modifier keys
+    { GLFW_KEY_LEFT_SHIFT, "LFSH" },
+    { GLFW_KEY_LEFT_CONTROL, "LCTL" },
+    { GLFW_KEY_LEFT_ALT, "LALT" },
+    { GLFW_KEY_LEFT_SUPER, "LWIN" },
+    { GLFW_KEY_RIGHT_SHIFT, "RTSH" },
+    { GLFW_KEY_RIGHT_CONTROL, "RCTL" },
+    { GLFW_KEY_RIGHT_ALT, "RALT" },
+    { GLFW_KEY_RIGHT_SUPER, "RWIN" },
+    { GLFW_KEY_MENU, "COMP" }
+};
+
+// Packs an XKB key name into an integer, as names are at most four characters
+//
+static uint32_t packKeyName(const char* name)
+{
+    return ((uint32_t) (unsigned char) name[0] << 24) |
+           ((uint32_t) (unsigned char) name[1] << 16) |
+           ((uint32_t) (unsigned char) name[2] << 8) |
+           ((uint32_t) (unsigned char) name[3]);
+}
+
+// Returns the GLFW key with the specified packed XKB key name
+//
+static int findKeyName(const uint32_t* packed, uint32_t name)
+{
+    int i;
+
+    for (i = 0;  i < (int) (sizeof(keyNames) / sizeof(keyNames[0]));  i++)
+    {
+        if (packed[i] == name)
+            return keyNames[i].key;
+    }
+
+    return GLFW_KEY_UNKNOWN;
+}
+
 // Create key code translation tables
 //
 static void createKeyTables(void)
 {
-    int scancode, key;
+    int i, scancode, key;
 
     memset(_glfw.x11.keycodes, -1, sizeof(_glfw.x11.keycodes));
     memset(_glfw.x11.scancodes, -1, sizeof(_glfw.x11.scancodes));
@@ -240,75 +404,41 @@ static void createKeyTables(void)
         // Use XKB to determine physical key locations independently of the current
         // keyboard layout
 
-        char name[XkbKeyNameLength + 1];
+        uint32_t packed[sizeof(keyNames) / sizeof(keyNames[0])];
         XkbDescPtr desc = XkbGetMap(_glfw.x11.display, 0, XkbUseCoreKbd);
-        XkbGetNames(_glfw.x11.display, XkbKeyNamesMask, desc);
+        XkbGetNames(_glfw.x11.display, XkbKeyNamesMask | XkbKeyAliasesMask, desc);
+
+        for (i = 0;  i < (int) (sizeof(keyNames) / sizeof(keyNames[0]));  i++)
+            packed[i] = packKeyName(keyNames[i].name);
 
         // Find the X11 key code -> GLFW key code mapping
         for (scancode = desc->min_key_code;  scancode <= desc->max_key_code;  scancode++)
         {
-            memcpy(name, desc->names->keys[scancode].name, XkbKeyNameLength);
-            name[XkbKeyNameLength] = '\0';
-
-            // Map the key name to a GLFW key code. Note: We only map printable
-            // keys here, and we use the US keyboard layout. The rest of the
-            // keys (function keys) are mapped using traditional KeySym
-            // translations.
-            if (strcmp(name, "TLDE") == 0) key = GLFW_KEY_GRAVE_ACCENT;
-            else if (strcmp(name, "AE01") == 0) key = GLFW_KEY_1;
-            else if (strcmp(name, "AE02") == 0) key = GLFW_KEY_2;
-            else if (strcmp(name, "AE03") == 0) key = GLFW_KEY_3;
-            else if (strcmp(name, "AE04") == 0) key = GLFW_KEY_4;
-            else if (strcmp(name, "AE05") == 0) key = GLFW_KEY_5;
-            else if (strcmp(name, "AE06") == 0) key = GLFW_KEY_6;
-            else if (strcmp(name, "AE07") == 0) key = GLFW_KEY_7;
-            else if (strcmp(name, "AE08") == 0) key = GLFW_KEY_8;
-            else if (strcmp(name, "AE09") == 0) key = GLFW_KEY_9;
-            else if (strcmp(name, "AE10") == 0) key = GLFW_KEY_0;
-            else if (strcmp(name, "AE11") == 0) key = GLFW_KEY_MINUS;
-            else if (strcmp(name, "AE12") == 0) key = GLFW_KEY_EQUAL;
-            else if (strcmp(name, "AD01") == 0) key = GLFW_KEY_Q;
-            else if (strcmp(name, "AD02") == 0) key = GLFW_KEY_W;
-            else if (strcmp(name, "AD03") == 0) key = GLFW_KEY_E;
-            else if (strcmp(name, "AD04") == 0) key = GLFW_KEY_R;
-            else if (strcmp(name, "AD05") == 0) key = GLFW_KEY_T;
-            else if (strcmp(name, "AD06") == 0) key = GLFW_KEY_Y;
-            else if (strcmp(name, "AD07") == 0) key = GLFW_KEY_U;
-            else if (strcmp(name, "AD08") == 0) key = GLFW_KEY_I;
-            else if (strcmp(name, "AD09") == 0) key = GLFW_KEY_O;
-            else if (strcmp(name, "AD10") == 0) key = GLFW_KEY_P;
-            else if (strcmp(name, "AD11") == 0) key = GLFW_KEY_LEFT_BRACKET;
-            else if (strcmp(name, "AD12") == 0) key = GLFW_KEY_RIGHT_BRACKET;
-            else if (strcmp(name, "AC01") == 0) key = GLFW_KEY_A;
-            else if (strcmp(name, "AC02") == 0) key = GLFW_KEY_S;
-            else if (strcmp(name, "AC03") == 0) key = GLFW_KEY_D;
-            else if (strcmp(name, "AC04") == 0) key = GLFW_KEY_F;
-            else if (strcmp(name, "AC05") == 0) key = GLFW_KEY_G;
-            else if (strcmp(name, "AC06") == 0) key = GLFW_KEY_H;
-            else if (strcmp(name, "AC07") == 0) key = GLFW_KEY_J;
-            else if (strcmp(name, "AC08") == 0) key = GLFW_KEY_K;
-            else if (strcmp(name, "AC09") == 0) key = GLFW_KEY_L;
-            else if (strcmp(name, "AC10") == 0) key = GLFW_KEY_SEMICOLON;
-            else if (strcmp(name, "AC11") == 0) key = GLFW_KEY_APOSTROPHE;
-            else if (strcmp(name, "AB01") == 0) key = GLFW_KEY_Z;
-            else if (strcmp(name, "AB02") == 0) key = GLFW_KEY_X;
-            else if (strcmp(name, "AB03") == 0) key = GLFW_KEY_C;
-            else if (strcmp(name, "AB04") == 0) key = GLFW_KEY_V;
-            else if (strcmp(name, "AB05") == 0) key = GLFW_KEY_B;
-            else if (strcmp(name, "AB06") == 0) key = GLFW_KEY_N;
-            else if (strcmp(name, "AB07") == 0) key = GLFW_KEY_M;
-            else if (strcmp(name, "AB08") == 0) key = GLFW_KEY_COMMA;
-            else if (strcmp(name, "AB09") == 0) key = GLFW_KEY_PERIOD;
-            else if (strcmp(name, "AB10") == 0) key = GLFW_KEY_SLASH;
-            else if (strcmp(name, "BKSL") == 0) key = GLFW_KEY_BACKSLASH;
-            else if (strcmp(name, "LSGT") == 0) key = GLFW_KEY_WORLD_1;
-            else key = GLFW_KEY_UNKNOWN;
-
-            if ((scancode >= 0) && (scancode < 256))
+            const uint32_t name = packKeyName(desc->names->keys[scancode].name);
+
+            key = findKeyName(packed, name);
+
+            // Fall back to the aliases of the key name, as some keyboards
+            // name keys differently than the table above
+            for (i = 0;  i < desc->names->num_key_aliases;  i++)
+            {
+                if (key != GLFW_KEY_UNKNOWN)
+                    break;
+
+                if (packKeyName(desc->names->key_aliases[i].real) == name)
+                {
+                    key = findKeyName(packed,
+                                      packKeyName(desc->names->key_aliases[i].alias));
+                }
+            }
+
+            // NOTE: Keys with unknown names are left for the KeySym
+            //       translation below
+            if (key != GLFW_KEY_UNKNOWN && scancode >= 0 && scancode < 256)
                 _glfw.x11.keycodes[scancode] = key;
         }
 
-        XkbFreeNames(desc, XkbKeyNamesMask, True);
+        XkbFreeNames(desc, XkbKeyNamesMask | XkbKeyAliasesMask, True);
         XkbFreeKeyboard(desc, 0, True);
     }
 
@@ -349,14 +479,111 @@ static GLFWbool hasUsableInputMethodStyle(void)
     return found;
 }
 
+// Indices of the extensions queried by queryExtensions
+//
+#define _GLFW_EXT_RANDR     0
+#define _GLFW_EXT_XINERAMA  1
+#define _GLFW_EXT_XINPUT    2
+#define _GLFW_EXT_XKB       3
+#define _GLFW_EXT_VIDMODE   4
+#define _GLFW_EXT_COUNT     5
+
+// Interns all atoms used by GLFW with a single round trip
+//
+static void internAtoms(void)
+{
+    int i;
+    char* names[64];
+    Atom atoms[64];
+    const struct
+    {
+        const char* name;
+        Atom* atom;
+    } entries[] =
+    {
+        // EWMH detection atoms
+        { "_NET_SUPPORTED", &_glfw.x11.NET_SUPPORTED },
+        { "_NET_SUPPORTING_WM_CHECK", &_glfw.x11.NET_SUPPORTING_WM_CHECK },
+
+        // EWMH atoms that require WM support, filtered by detectEWMH
+        { "_NET_WM_STATE", &_glfw.x11.NET_WM_STATE },
+        { "_NET_WM_STATE_ABOVE", &_glfw.x11.NET_WM_STATE_ABOVE },
+        { "_NET_WM_STATE_FULLSCREEN", &_glfw.x11.NET_WM_STATE_FULLSCREEN },
+        { "_NET_WM_STATE_MAXIMIZED_VERT", &_glfw.x11.NET_WM_STATE_MAXIMIZED_VERT },
+        { "_NET_WM_STATE_MAXIMIZED_HORZ", &_glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ },
+        { "_NET_WM_STATE_DEMANDS_ATTENTION", &_glfw.x11.NET_WM_STATE_DEMANDS_ATTENTION },
+        { "_NET_WM_FULLSCREEN_MONITORS", &_glfw.x11.NET_WM_FULLSCREEN_MONITORS },
+        { "_NET_WM_WINDOW_TYPE", &_glfw.x11.NET_WM_WINDOW_TYPE },
+        { "_NET_WM_WINDOW_TYPE_NORMAL", &_glfw.x11.NET_WM_WINDOW_TYPE_NORMAL },
+        { "_NET_ACTIVE_WINDOW", &_glfw.x11.NET_ACTIVE_WINDOW },
+        { "_NET_FRAME_EXTENTS", &_glfw.x11.NET_FRAME_EXTENTS },
+        { "_NET_REQUEST_FRAME_EXTENTS", &_glfw.x11.NET_REQUEST_FRAME_EXTENTS },
+
+        // String format atoms
+        { "NULL", &_glfw.x11.NULL_ },
+        { "UTF8_STRING", &_glfw.x11.UTF8_STRING },
+        { "COMPOUND_STRING", &_glfw.x11.COMPOUND_STRING },
+        { "ATOM_PAIR", &_glfw.x11.ATOM_PAIR },
+
+        // Custom selection property atom
+        { "GLFW_SELECTION", &_glfw.x11.GLFW_SELECTION },
+
+        // ICCCM standard clipboard atoms
+        { "TARGETS", &_glfw.x11.TARGETS },
+        { "MULTIPLE", &_glfw.x11.MULTIPLE },
+        { "CLIPBOARD", &_glfw.x11.CLIPBOARD },
+        { "INCR", &_glfw.x11.INCR },
+
+        // Clipboard manager atoms
+        { "CLIPBOARD_MANAGER", &_glfw.x11.CLIPBOARD_MANAGER },
+        { "SAVE_TARGETS", &_glfw.x11.SAVE_TARGETS },
+
+        // Xdnd (drag and drop) atoms
+        { "XdndAware", &_glfw.x11.XdndAware },
+        { "XdndEnter", &_glfw.x11.XdndEnter },
+        { "XdndPosition", &_glfw.x11.XdndPosition },
+        { "XdndStatus", &_glfw.x11.XdndStatus },
+        { "XdndActionCopy", &_glfw.x11.XdndActionCopy },
+        { "XdndDrop", &_glfw.x11.XdndDrop },
+        { "XdndFinished", &_glfw.x11.XdndFinished },
+        { "XdndSelection", &_glfw.x11.XdndSelection },
+        { "XdndTypeList", &_glfw.x11.XdndTypeList },
+        { "text/uri-list", &_glfw.x11.text_uri_list },
+
+        // ICCCM, EWMH and Motif window property atoms
+        // These can be set safely even without WM support
+        { "WM_PROTOCOLS", &_glfw.x11.WM_PROTOCOLS },
+        { "WM_STATE", &_glfw.x11.WM_STATE },
+        { "WM_DELETE_WINDOW", &_glfw.x11.WM_DELETE_WINDOW },
+        { "_NET_WM_ICON", &_glfw.x11.NET_WM_ICON },
+        { "_NET_WM_PING", &_glfw.x11.NET_WM_PING },
+        { "_NET_WM_PID", &_glfw.x11.NET_WM_PID },
+        { "_NET_WM_NAME", &_glfw.x11.NET_WM_NAME },
+        { "_NET_WM_ICON_NAME", &_glfw.x11.NET_WM_ICON_NAME },
+        { "_NET_WM_BYPASS_COMPOSITOR", &_glfw.x11.NET_WM_BYPASS_COMPOSITOR },
+        { "_MOTIF_WM_HINTS", &_glfw.x11.MOTIF_WM_HINTS }
+    };
+    const int count = sizeof(entries) / sizeof(entries[0]);
+
+    assert(count <= (int) (sizeof(names) / sizeof(names[0])));
+
+    for (i = 0;  i < count;  i++)
+        names[i] = (char*) entries[i].name;
+
+    // NOTE: XInternAtoms sends all requests before waiting for any reply
+    XInternAtoms(_glfw.x11.display, names, count, False, atoms);
+
+    for (i = 0;  i < count;  i++)
+        *entries[i].atom = atoms[i];
+}
+
 // Check whether the specified atom is supported
 //
 static Atom getSupportedAtom(Atom* supportedAtoms,
                              unsigned long atomCount,
-                             const char* atomName)
+                             Atom atom)
 {
     unsigned long i;
-    const Atom atom = XInternAtom(_glfw.x11.display, atomName, False);
 
     for (i = 0;  i < atomCount;  i++)
     {
@@ -371,22 +598,51 @@ static Atom getSupportedAtom(Atom* supportedAtoms,
 //
 static void detectEWMH(void)
 {
+    int i;
     Window* windowFromRoot = NULL;
     Window* windowFromChild = NULL;
-
-    // First we need a couple of atoms
-    const Atom supportingWmCheck =
-        XInternAtom(_glfw.x11.display, "_NET_SUPPORTING_WM_CHECK", False);
-    const Atom wmSupported =
-        XInternAtom(_glfw.x11.display, "_NET_SUPPORTED", False);
-
-    // Then we look for the _NET_SUPPORTING_WM_CHECK property of the root window
-    if (!_glfwGetWindowPropertyX11(_glfw.x11.root,
-                                   supportingWmCheck,
-                                   XA_WINDOW,
-                                   (unsigned char**) &windowFromRoot))
+    Atom* supportedAtoms = NULL;
+    unsigned long atomCount;
+    Atom* atoms[] =
     {
-        return;
+        &_glfw.x11.NET_WM_STATE,
+        &_glfw.x11.NET_WM_STATE_ABOVE,
+        &_glfw.x11.NET_WM_STATE_FULLSCREEN,
+        &_glfw.x11.NET_WM_STATE_MAXIMIZED_VERT,
+        &_glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ,
+        &_glfw.x11.NET_WM_STATE_DEMANDS_ATTENTION,
+        &_glfw.x11.NET_WM_FULLSCREEN_MONITORS,
+        &_glfw.x11.NET_WM_WINDOW_TYPE,
+        &_glfw.x11.NET_WM_WINDOW_TYPE_NORMAL,
+        &_glfw.x11.NET_ACTIVE_WINDOW,
+        &_glfw.x11.NET_FRAME_EXTENTS,
+        &_glfw.x11.NET_REQUEST_FRAME_EXTENTS
+    };
+
+    GLFWbool compliant = GLFW_FALSE;
+    _GLFWpropertyrequestX11 checkRequest, supportedRequest;
+
+    // We need the _NET_SUPPORTING_WM_CHECK and _NET_SUPPORTED properties of
+    // the root window, so request both before waiting for either
+    _glfwRequestWindowPropertyX11(&checkRequest,
+                                  _glfw.x11.root,
+                                  _glfw.x11.NET_SUPPORTING_WM_CHECK,
+                                  XA_WINDOW);
+    _glfwRequestWindowPropertyX11(&supportedRequest,
+                                  _glfw.x11.root,
+                                  _glfw.x11.NET_SUPPORTED,
+                                  XA_ATOM);
+
+    // The _NET_SUPPORTED property should be a list of supported WM protocol
+    // and state atoms, but is only trusted if the check below succeeds
+    atomCount = _glfwReadWindowPropertyX11(&supportedRequest,
+                                           (unsigned char**) &supportedAtoms);
+
+    // First we look for the _NET_SUPPORTING_WM_CHECK property of the root window
+    if (!_glfwReadWindowPropertyX11(&checkRequest,
+                                    (unsigned char**) &windowFromRoot))
+    {
+        goto unsupported;
     }
 
     _glfwGrabErrorHandlerX11();
@@ -394,104 +650,184 @@ static void detectEWMH(void)
     // It should be the ID of a child window (of the root)
     // Then we look for the same property on the child window
     if (!_glfwGetWindowPropertyX11(*windowFromRoot,
-                                   supportingWmCheck,
+                                   _glfw.x11.NET_SUPPORTING_WM_CHECK,
                                    XA_WINDOW,
                                    (unsigned char**) &windowFromChild))
     {
+        _glfwReleaseErrorHandlerX11();
         XFree(windowFromRoot);
-        return;
+        goto unsupported;
     }
 
     _glfwReleaseErrorHandlerX11();
 
     // It should be the ID of that same child window
-    if (*windowFromRoot != *windowFromChild)
+    if (*windowFromRoot == *windowFromChild)
     {
-        XFree(windowFromRoot);
-        XFree(windowFromChild);
-        return;
+        // We are now fairly sure that an EWMH-compliant window manager is running
+        compliant = GLFW_TRUE;
     }
 
     XFree(windowFromRoot);
     XFree(windowFromChild);
 
-    // We are now fairly sure that an EWMH-compliant window manager is running
-
-    Atom* supportedAtoms;
-    unsigned long atomCount;
+unsupported:
 
-    // Now we need to check the _NET_SUPPORTED property of the root window
-    // It should be a list of supported WM protocol and state atoms
-    atomCount = _glfwGetWindowPropertyX11(_glfw.x11.root,
-                                          wmSupported,
-                                          XA_ATOM,
-                                          (unsigned char**) &supportedAtoms);
+    if (!compliant)
+        atomCount = 0;
 
     // See which of the atoms we support that are supported by the WM
-    _glfw.x11.NET_WM_STATE =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_STATE");
-    _glfw.x11.NET_WM_STATE_ABOVE =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_STATE_ABOVE");
-    _glfw.x11.NET_WM_STATE_FULLSCREEN =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_STATE_FULLSCREEN");
-    _glfw.x11.NET_WM_STATE_MAXIMIZED_VERT =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_STATE_MAXIMIZED_VERT");
-    _glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_STATE_MAXIMIZED_HORZ");
-    _glfw.x11.NET_WM_STATE_DEMANDS_ATTENTION =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_STATE_DEMANDS_ATTENTION");
-    _glfw.x11.NET_WM_FULLSCREEN_MONITORS =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_FULLSCREEN_MONITORS");
-    _glfw.x11.NET_WM_WINDOW_TYPE =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_WINDOW_TYPE");
-    _glfw.x11.NET_WM_WINDOW_TYPE_NORMAL =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_WINDOW_TYPE_NORMAL");
-    _glfw.x11.NET_ACTIVE_WINDOW =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_ACTIVE_WINDOW");
-    _glfw.x11.NET_FRAME_EXTENTS =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_FRAME_EXTENTS");
-    _glfw.x11.NET_REQUEST_FRAME_EXTENTS =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_REQUEST_FRAME_EXTENTS");
+    for (i = 0;  i < (int) (sizeof(atoms) / sizeof(atoms[0]));  i++)
+        *atoms[i] = getSupportedAtom(supportedAtoms, atomCount, *atoms[i]);
 
     if (supportedAtoms)
         XFree(supportedAtoms);
 }
 
+// Queries the presence of the specified extensions, sending all requests
+// before waiting for any reply
+// Returns GLFW_FALSE if XCB is unavailable and nothing was learned
+//
+static GLFWbool queryExtensions(const char** names,
+                                int count,
+                                GLFWbool* present,
+                                XExtCodes* codes)
+{
+    int i;
+    xcb_query_extension_cookie_t cookies[_GLFW_EXT_COUNT];
+
+    assert(count <= _GLFW_EXT_COUNT);
+
+    if (!_glfw.x11.xcb.connection)
+        return GLFW_FALSE;
+
+    for (i = 0;  i < count;  i++)
+    {
+        cookies[i] = xcb_query_extension(_glfw.x11.xcb.connection,
+                                         (uint16_t) strlen(names[i]),
+                                         names[i]);
+    }
+
+    for (i = 0;  i < count;  i++)
+    {
+        xcb_query_extension_reply_t* reply =
+            xcb_query_extension_reply(_glfw.x11.xcb.connection, cookies[i], NULL);
+        if (reply)
+        {
+            present[i] = reply->present;
+            codes[i].extension = i;
+            codes[i].major_opcode = reply->major_opcode;
+            codes[i].first_event = reply->first_event;
+            codes[i].first_error = reply->first_error;
+            free(reply);
+        }
+        else
+            present[i] = GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
+}
+
 // Look for and initialize supported X11 extensions
 //
 static GLFWbool initExtensions(void)
 {
-    _glfw.x11.vidmode.handle = dlopen("libXxf86vm.so.1", RTLD_LAZY | RTLD_GLOBAL);
-    if (_glfw.x11.vidmode.handle)
-    {
-        _glfw.x11.vidmode.QueryExtension = (PFN_XF86VidModeQueryExtension)
-            dlsym(_glfw.x11.vidmode.handle, "XF86VidModeQueryExtension");
-        _glfw.x11.vidmode.GetGammaRamp = (PFN_XF86VidModeGetGammaRamp)
-            dlsym(_glfw.x11.vidmode.handle, "XF86VidModeGetGammaRamp");
-        _glfw.x11.vidmode.SetGammaRamp = (PFN_XF86VidModeSetGammaRamp)
-            dlsym(_glfw.x11.vidmode.handle, "XF86VidModeSetGammaRamp");
-        _glfw.x11.vidmode.GetGammaRampSize = (PFN_XF86VidModeGetGammaRampSize)
-            dlsym(_glfw.x11.vidmode.handle, "XF86VidModeGetGammaRampSize");
-
-        _glfw.x11.vidmode.available =
-            XF86VidModeQueryExtension(_glfw.x11.display,
-                                      &_glfw.x11.vidmode.eventBase,
-                                      &_glfw.x11.vidmode.errorBase);
+    int i;
+    GLFWbool known;
+    GLFWbool present[_GLFW_EXT_COUNT];
+    XExtCodes codes[_GLFW_EXT_COUNT];
+    const char* names[_GLFW_EXT_COUNT] =
+    {
+        "RANDR",
+        "XINERAMA",
+        "XInputExtension",
+        "XKEYBOARD",
+        "XFree86-VidModeExtension"
+    };
+
+    _glfw.x11.x11xcb.handle = dlopen("libX11-xcb.so.1", RTLD_LAZY | RTLD_GLOBAL);
+    if (_glfw.x11.x11xcb.handle)
+    {
+        _glfw.x11.x11xcb.XGetXCBConnection = (PFN_XGetXCBConnection)
+            dlsym(_glfw.x11.x11xcb.handle, "XGetXCBConnection");
+
+        _glfw.x11.xcb.handle = dlopen("libxcb.so.1", RTLD_LAZY | RTLD_GLOBAL);
+        if (_glfw.x11.xcb.handle)
+        {
+            _glfw.x11.xcb.query_extension = (PFN_xcb_query_extension)
+                dlsym(_glfw.x11.xcb.handle, "xcb_query_extension");
+            _glfw.x11.xcb.query_extension_reply = (PFN_xcb_query_extension_reply)
+                dlsym(_glfw.x11.xcb.handle, "xcb_query_extension_reply");
+            _glfw.x11.xcb.get_property = (PFN_xcb_get_property)
+                dlsym(_glfw.x11.xcb.handle, "xcb_get_property");
+            _glfw.x11.xcb.get_property_reply = (PFN_xcb_get_property_reply)
+                dlsym(_glfw.x11.xcb.handle, "xcb_get_property_reply");
+            _glfw.x11.xcb.get_property_value = (PFN_xcb_get_property_value)
+                dlsym(_glfw.x11.xcb.handle, "xcb_get_property_value");
+            _glfw.x11.xcb.query_pointer = (PFN_xcb_query_pointer)
+                dlsym(_glfw.x11.xcb.handle, "xcb_query_pointer");
+            _glfw.x11.xcb.query_pointer_reply = (PFN_xcb_query_pointer_reply)
+                dlsym(_glfw.x11.xcb.handle, "xcb_query_pointer_reply");
+            _glfw.x11.xcb.translate_coordinates = (PFN_xcb_translate_coordinates)
+                dlsym(_glfw.x11.xcb.handle, "xcb_translate_coordinates");
+            _glfw.x11.xcb.translate_coordinates_reply = (PFN_xcb_translate_coordinates_reply)
+                dlsym(_glfw.x11.xcb.handle, "xcb_translate_coordinates_reply");
+            _glfw.x11.xcb.get_geometry = (PFN_xcb_get_geometry)
+                dlsym(_glfw.x11.xcb.handle, "xcb_get_geometry");
+            _glfw.x11.xcb.get_geometry_reply = (PFN_xcb_get_geometry_reply)
+                dlsym(_glfw.x11.xcb.handle, "xcb_get_geometry_reply");
+            _glfw.x11.xcb.get_window_attributes = (PFN_xcb_get_window_attributes)
+                dlsym(_glfw.x11.xcb.handle, "xcb_get_window_attributes");
+            _glfw.x11.xcb.get_window_attributes_reply = (PFN_xcb_get_window_attributes_reply)
+                dlsym(_glfw.x11.xcb.handle, "xcb_get_window_attributes_reply");
+
+            if (_glfw.x11.x11xcb.XGetXCBConnection &&
+                _glfw.x11.xcb.query_extension &&
+                _glfw.x11.xcb.query_extension_reply &&
+                _glfw.x11.xcb.get_property &&
+                _glfw.x11.xcb.get_property_reply &&
+                _glfw.x11.xcb.get_property_value &&
+                _glfw.x11.xcb.query_pointer &&
+                _glfw.x11.xcb.query_pointer_reply &&
+                _glfw.x11.xcb.translate_coordinates &&
+                _glfw.x11.xcb.translate_coordinates_reply &&
+                _glfw.x11.xcb.get_geometry &&
+                _glfw.x11.xcb.get_geometry_reply &&
+                _glfw.x11.xcb.get_window_attributes &&
+                _glfw.x11.xcb.get_window_attributes_reply)
+            {
+                _glfw.x11.xcb.connection =
+                    _glfw.x11.x11xcb.XGetXCBConnection(_glfw.x11.display);
+            }
+        }
     }
 
+    // Without XCB each extension is queried by its own functions below
+    for (i = 0;  i < _GLFW_EXT_COUNT;  i++)
+        present[i] = GLFW_TRUE;
+
+    known = queryExtensions(names, _GLFW_EXT_COUNT, present, codes);
+
     _glfw.x11.xi.handle = dlopen("libXi.so.6", RTLD_LAZY | RTLD_GLOBAL);
-    if (_glfw.x11.xi.handle)
+    if (_glfw.x11.xi.handle && present[_GLFW_EXT_XINPUT])
     {
         _glfw.x11.xi.QueryVersion = (PFN_XIQueryVersion)
             dlsym(_glfw.x11.xi.handle, "XIQueryVersion");
         _glfw.x11.xi.SelectEvents = (PFN_XISelectEvents)
             dlsym(_glfw.x11.xi.handle, "XISelectEvents");
 
-        if (XQueryExtension(_glfw.x11.display,
-                            "XInputExtension",
-                            &_glfw.x11.xi.majorOpcode,
-                            &_glfw.x11.xi.eventBase,
-                            &_glfw.x11.xi.errorBase))
+        if (known)
+        {
+            _glfw.x11.xi.majorOpcode = codes[_GLFW_EXT_XINPUT].major_opcode;
+            _glfw.x11.xi.eventBase = codes[_GLFW_EXT_XINPUT].first_event;
+            _glfw.x11.xi.errorBase = codes[_GLFW_EXT_XINPUT].first_error;
+        }
+
+        if (known || XQueryExtension(_glfw.x11.display,
+                                     "XInputExtension",
+                                     &_glfw.x11.xi.majorOpcode,
+                                     &_glfw.x11.xi.eventBase,
+                                     &_glfw.x11.xi.errorBase))
         {
             _glfw.x11.xi.major = 2;
             _glfw.x11.xi.minor = 0;
@@ -505,7 +841,8 @@ static GLFWbool initExtensions(void)
         }
     }
 
-    if (XRRQueryExtension(_glfw.x11.display,
+    if (present[_GLFW_EXT_RANDR] &&
+        XRRQueryExtension(_glfw.x11.display,
                           &_glfw.x11.randr.eventBase,
                           &_glfw.x11.randr.errorBase))
     {
@@ -549,10 +886,33 @@ static GLFWbool initExtensions(void)
     if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
     {
         XRRSelectInput(_glfw.x11.display, _glfw.x11.root,
-                       RROutputChangeNotifyMask);
+                       RRCrtcChangeNotifyMask | RROutputChangeNotifyMask);
     }
 
-    if (XineramaQueryExtension(_glfw.x11.display,
+    // The xf86vm extension is only used for gamma when RandR gamma is unusable
+    if (!_glfw.x11.randr.available || _glfw.x11.randr.gammaBroken)
+    {
+        _glfw.x11.vidmode.handle = dlopen("libXxf86vm.so.1", RTLD_LAZY | RTLD_GLOBAL);
+        if (_glfw.x11.vidmode.handle && present[_GLFW_EXT_VIDMODE])
+        {
+            _glfw.x11.vidmode.QueryExtension = (PFN_XF86VidModeQueryExtension)
+                dlsym(_glfw.x11.vidmode.handle, "XF86VidModeQueryExtension");
+            _glfw.x11.vidmode.GetGammaRamp = (PFN_XF86VidModeGetGammaRamp)
+                dlsym(_glfw.x11.vidmode.handle, "XF86VidModeGetGammaRamp");
+            _glfw.x11.vidmode.SetGammaRamp = (PFN_XF86VidModeSetGammaRamp)
+                dlsym(_glfw.x11.vidmode.handle, "XF86VidModeSetGammaRamp");
+            _glfw.x11.vidmode.GetGammaRampSize = (PFN_XF86VidModeGetGammaRampSize)
+                dlsym(_glfw.x11.vidmode.handle, "XF86VidModeGetGammaRampSize");
+
+            _glfw.x11.vidmode.available =
+                XF86VidModeQueryExtension(_glfw.x11.display,
+                                          &_glfw.x11.vidmode.eventBase,
+                                          &_glfw.x11.vidmode.errorBase);
+        }
+    }
+
+    if (present[_GLFW_EXT_XINERAMA] &&
+        XineramaQueryExtension(_glfw.x11.display,
                                &_glfw.x11.xinerama.major,
                                &_glfw.x11.xinerama.minor))
     {
@@ -560,15 +920,18 @@ static GLFWbool initExtensions(void)
             _glfw.x11.xinerama.available = GLFW_TRUE;
     }
 
-    _glfw.x11.xkb.major = 1;
-    _glfw.x11.xkb.minor = 0;
-    _glfw.x11.xkb.available =
-        XkbQueryExtension(_glfw.x11.display,
-                          &_glfw.x11.xkb.majorOpcode,
-                          &_glfw.x11.xkb.eventBase,
-                          &_glfw.x11.xkb.errorBase,
-                          &_glfw.x11.xkb.major,
-                          &_glfw.x11.xkb.minor);
+    if (present[_GLFW_EXT_XKB])
+    {
+        _glfw.x11.xkb.major = 1;
+        _glfw.x11.xkb.minor = 0;
+        _glfw.x11.xkb.available =
+            XkbQueryExtension(_glfw.x11.display,
+                              &_glfw.x11.xkb.majorOpcode,
+                              &_glfw.x11.xkb.eventBase,
+                              &_glfw.x11.xkb.errorBase,
+                              &_glfw.x11.xkb.major,
+                              &_glfw.x11.xkb.minor);
+    }
 
     if (_glfw.x11.xkb.available)
     {
@@ -581,80 +944,16 @@ static GLFWbool initExtensions(void)
         }
     }
 
-    _glfw.x11.x11xcb.handle = dlopen("libX11-xcb.so.1", RTLD_LAZY | RTLD_GLOBAL);
-    if (_glfw.x11.x11xcb.handle)
-    {
-        _glfw.x11.x11xcb.XGetXCBConnection = (PFN_XGetXCBConnection)
-            dlsym(_glfw.x11.x11xcb.handle, "XGetXCBConnection");
-    }
-
     // Update the key code LUT
     // FIXME: We should listen to XkbMapNotify events to track changes to
     // the keyboard mapping.
     createKeyTables();
 
-    // Detect whether an EWMH-conformant window manager is running
+    // Intern all atoms, then detect whether an EWMH-conformant window manager
+    // is running
+    internAtoms();
     detectEWMH();
 
-    // String format atoms
-    _glfw.x11.NULL_ = XInternAtom(_glfw.x11.display, "NULL", False);
-    _glfw.x11.UTF8_STRING =
-        XInternAtom(_glfw.x11.display, "UTF8_STRING", False);
-    _glfw.x11.COMPOUND_STRING =
-        XInternAtom(_glfw.x11.display, "COMPOUND_STRING", False);
-    _glfw.x11.ATOM_PAIR = XInternAtom(_glfw.x11.display, "ATOM_PAIR", False);
-
-    // Custom selection property atom
-    _glfw.x11.GLFW_SELECTION =
-        XInternAtom(_glfw.x11.display, "GLFW_SELECTION", False);
-
-    // ICCCM standard clipboard atoms
-    _glfw.x11.TARGETS = XInternAtom(_glfw.x11.display, "TARGETS", False);
-    _glfw.x11.MULTIPLE = XInternAtom(_glfw.x11.display, "MULTIPLE", False);
-    _glfw.x11.CLIPBOARD = XInternAtom(_glfw.x11.display, "CLIPBOARD", False);
-
-    // Clipboard manager atoms
-    _glfw.x11.CLIPBOARD_MANAGER =
-        XInternAtom(_glfw.x11.display, "CLIPBOARD_MANAGER", False);
-    _glfw.x11.SAVE_TARGETS =
-        XInternAtom(_glfw.x11.display, "SAVE_TARGETS", False);
-
-    // Xdnd (drag and drop) atoms
-    _glfw.x11.XdndAware = XInternAtom(_glfw.x11.display, "XdndAware", False);
-    _glfw.x11.XdndEnter = XInternAtom(_glfw.x11.display, "XdndEnter", False);
-    _glfw.x11.XdndPosition = XInternAtom(_glfw.x11.display, "XdndPosition", False);
-    _glfw.x11.XdndStatus = XInternAtom(_glfw.x11.display, "XdndStatus", False);
-    _glfw.x11.XdndActionCopy = XInternAtom(_glfw.x11.display, "XdndActionCopy", False);
-    _glfw.x11.XdndDrop = XInternAtom(_glfw.x11.display, "XdndDrop", False);
-    _glfw.x11.XdndFinished = XInternAtom(_glfw.x11.display, "XdndFinished", False);
-    _glfw.x11.XdndSelection = XInternAtom(_glfw.x11.display, "XdndSelection", False);
-    _glfw.x11.XdndTypeList = XInternAtom(_glfw.x11.display, "XdndTypeList", False);
-    _glfw.x11.text_uri_list = XInternAtom(_glfw.x11.display, "text/uri-list", False);
-
-    // ICCCM, EWMH and Motif window property atoms
-    // These can be set safely even without WM support
-    // The EWMH atoms that require WM support are handled in detectEWMH
-    _glfw.x11.WM_PROTOCOLS =
-        XInternAtom(_glfw.x11.display, "WM_PROTOCOLS", False);
-    _glfw.x11.WM_STATE =
-        XInternAtom(_glfw.x11.display, "WM_STATE", False);
-    _glfw.x11.WM_DELETE_WINDOW =
-        XInternAtom(_glfw.x11.display, "WM_DELETE_WINDOW", False);
-    _glfw.x11.NET_WM_ICON =
-        XInternAtom(_glfw.x11.display, "_NET_WM_ICON", False);
-    _glfw.x11.NET_WM_PING =
-        XInternAtom(_glfw.x11.display, "_NET_WM_PING", False);
-    _glfw.x11.NET_WM_PID =
-        XInternAtom(_glfw.x11.display, "_NET_WM_PID", False);
-    _glfw.x11.NET_WM_NAME =
-        XInternAtom(_glfw.x11.display, "_NET_WM_NAME", False);
-    _glfw.x11.NET_WM_ICON_NAME =
-        XInternAtom(_glfw.x11.display, "_NET_WM_ICON_NAME", False);
-    _glfw.x11.NET_WM_BYPASS_COMPOSITOR =
-        XInternAtom(_glfw.x11.display, "_NET_WM_BYPASS_COMPOSITOR", False);
-    _glfw.x11.MOTIF_WM_HINTS =
-        XInternAtom(_glfw.x11.display, "_MOTIF_WM_HINTS", False);
-
     return GLFW_TRUE;
 }
 
@@ -726,7 +1025,6 @@ void _glfwInputErrorX11(int error, const char* message)
 //
 Cursor _glfwCreateCursorX11(const GLFWimage* image, int xhot, int yhot)
 {
-    int i;
     Cursor cursor;
 
     XcursorImage* native = XcursorImageCreate(image->width, image->height);
@@ -736,18 +1034,9 @@ Cursor _glfwCreateCursorX11(const GLFWimage* image, int xhot, int yhot)
     native->xhot = xhot;
     native->yhot = yhot;
 
-    unsigned char* source = (unsigned char*) image->pixels;
-    XcursorPixel* target = native->pixels;
-
-    for (i = 0;  i < image->width * image->height;  i++, target++, source += 4)
-    {
-        unsigned int alpha = source[3];
-
-        *target = (alpha << 24) |
-                  ((unsigned char) ((source[0] * alpha) / 255) << 16) |
-                  ((unsigned char) ((source[1] * alpha) / 255) <<  8) |
-                  ((unsigned char) ((source[2] * alpha) / 255) <<  0);
-    }
+    _glfwConvertToPremultipliedARGB((uint32_t*) native->pixels,
+                                    image->pixels,
+                                    (size_t) image->width * image->height);
 
     cursor = XcursorImageLoadCursor(_glfw.x11.display, native);
     XcursorImageDestroy(native);
@@ -829,6 +1118,8 @@ int _glfwPlatformInit(void)
 
 void _glfwPlatformTerminate(void)
 {
+    int i;
+
     if (_glfw.x11.x11xcb.handle)
     {
         dlclose(_glfw.x11.x11xcb.handle);
@@ -853,7 +1144,23 @@ void _glfwPlatformTerminate(void)
         _glfw.x11.hiddenCursorHandle = (Cursor) 0;
     }
 
+    // NOTE: All cursor objects and their shared cursors have been destroyed
+    free(_glfw.x11.sharedCursors);
+
     free(_glfw.x11.clipboardString);
+    free(_glfw.x11.clipboardLatin1);
+    for (i = 0;  i < _glfw.x11.incrCount;  i++)
+        free(_glfw.x11.incrs[i].copy);
+    free(_glfw.x11.incrs);
+    free(_glfw.x11.clipboardTargets);
+    free(_glfw.x11.clipboardData);
+
+    for (i = 0;  i < _glfw.x11.clipboardTypeCount;  i++)
+        free(_glfw.x11.clipboardTypes[i]);
+    free(_glfw.x11.clipboardTypes);
+    free(_glfw.x11.transfer.data);
+    free(_glfw.x11.randr.outputChanges);
+    free(_glfw.x11.xi.rawSamples);
 
     if (_glfw.x11.im)
     {
@@ -862,6 +1169,7 @@ void _glfwPlatformTerminate(void)
     }
 
     _glfwTerminateEGL();
+    _glfwTerminateOSMesa();
 
     if (_glfw.x11.display)
     {
@@ -869,6 +1177,14 @@ void _glfwPlatformTerminate(void)
         _glfw.x11.display = NULL;
     }
 
+    // NOTE: The XCB connection is used until the display is closed
+    _glfw.x11.xcb.connection = NULL;
+    if (_glfw.x11.xcb.handle)
+    {
+        dlclose(_glfw.x11.xcb.handle);
+        _glfw.x11.xcb.handle = NULL;
+    }
+
     // NOTE: This needs to be done after XCloseDisplay, as libGL registers
     //       cleanup callbacks that get called by it
     _glfwTerminateGLX();
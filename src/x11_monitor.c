@@ -90,6 +90,106 @@ static GLFWvidmode vidmodeFromModeInfo(const XRRModeInfo* mi,
     return mode;
 }
 
+// Lexically compares two video modes, used by qsort
+//
+static int compareVideoModes(const void* fp, const void* sp)
+{
+    return _glfwCompareVideoModes(fp, sp);
+}
+
+// Updates the cached CRTC position and current video mode, if necessary
+//
+static void refreshCrtcState(_GLFWmonitor* monitor)
+{
+    XRRScreenResources* sr;
+    XRRCrtcInfo* ci;
+
+    if (monitor->x11.crtcStateValid)
+        return;
+
+    sr = XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
+    ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
+
+    monitor->x11.xpos = ci->x;
+    monitor->x11.ypos = ci->y;
+    monitor->x11.currentMode = vidmodeFromModeInfo(getModeInfo(sr, ci->mode), ci);
+    monitor->x11.crtcStateValid = GLFW_TRUE;
+
+    XRRFreeCrtcInfo(ci);
+    XRRFreeScreenResources(sr);
+}
+
+// Connects a monitor for the specified output if it is connected to a CRTC
+//
+static void connectOutput(XRRScreenResources* sr,
+                          RROutput output,
+                          RROutput primary,
+                          const XineramaScreenInfo* screens,
+                          int screenCount)
+{
+    int i, type, widthMM, heightMM;
+    XRROutputInfo* oi;
+    XRRCrtcInfo* ci;
+    _GLFWmonitor* monitor;
+
+    oi = XRRGetOutputInfo(_glfw.x11.display, sr, output);
+    if (oi->connection != RR_Connected || oi->crtc == None)
+    {
+        XRRFreeOutputInfo(oi);
+        return;
+    }
+
+    ci = XRRGetCrtcInfo(_glfw.x11.display, sr, oi->crtc);
+    if (ci->rotation == RR_Rotate_90 || ci->rotation == RR_Rotate_270)
+    {
+        widthMM  = oi->mm_height;
+        heightMM = oi->mm_width;
+    }
+    else
+    {
+        widthMM  = oi->mm_width;
+        heightMM = oi->mm_height;
+    }
+
+    monitor = _glfwAllocMonitor(oi->name, widthMM, heightMM);
+    monitor->x11.output = output;
+    monitor->x11.crtc   = oi->crtc;
+
+    for (i = 0;  i < screenCount;  i++)
+    {
+        if (screens[i].x_org == ci->x &&
+            screens[i].y_org == ci->y &&
+            screens[i].width == ci->width &&
+            screens[i].height == ci->height)
+        {
+            monitor->x11.index = i;
+            break;
+        }
+    }
+
+    if (monitor->x11.output == primary)
+        type = _GLFW_INSERT_FIRST;
+    else
+        type = _GLFW_INSERT_LAST;
+
+    _glfwInputMonitor(monitor, GLFW_CONNECTED, type);
+
+    XRRFreeOutputInfo(oi);
+    XRRFreeCrtcInfo(ci);
+}
+
+// Connects a monitor for the whole screen, used when no outputs are available
+//
+static void connectPlaceholder(void)
+{
+    const int widthMM = DisplayWidthMM(_glfw.x11.display, _glfw.x11.screen);
+    const int heightMM = DisplayHeightMM(_glfw.x11.display, _glfw.x11.screen);
+
+    _glfwInputMonitor(_glfwAllocMonitor("Display", widthMM, heightMM),
+                      GLFW_CONNECTED,
+                      _GLFW_INSERT_FIRST);
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -123,95 +223,164 @@ void _glfwPollMonitorsX11(void)
 
         for (i = 0;  i < sr->noutput;  i++)
         {
-            int type, widthMM, heightMM;
-            XRROutputInfo* oi;
-            XRRCrtcInfo* ci;
-            _GLFWmonitor* monitor;
-
-            oi = XRRGetOutputInfo(_glfw.x11.display, sr, sr->outputs[i]);
-            if (oi->connection != RR_Connected || oi->crtc == None)
-            {
-                XRRFreeOutputInfo(oi);
-                continue;
-            }
-
             for (j = 0;  j < disconnectedCount;  j++)
             {
                 if (disconnected[j] &&
                     disconnected[j]->x11.output == sr->outputs[i])
                 {
-                    disconnected[j] = NULL;
                     break;
                 }
             }
 
             if (j < disconnectedCount)
             {
+                // NOTE: The monitor is kept only if its output is still
+                //       connected to a CRTC
+                XRROutputInfo* oi = XRRGetOutputInfo(_glfw.x11.display,
+                                                     sr, sr->outputs[i]);
+                if (oi->connection == RR_Connected && oi->crtc != None)
+                    disconnected[j] = NULL;
+
                 XRRFreeOutputInfo(oi);
                 continue;
             }
 
-            ci = XRRGetCrtcInfo(_glfw.x11.display, sr, oi->crtc);
-            if (ci->rotation == RR_Rotate_90 || ci->rotation == RR_Rotate_270)
+            connectOutput(sr, sr->outputs[i], primary, screens, screenCount);
+        }
+
+        XRRFreeScreenResources(sr);
+
+        if (screens)
+            XFree(screens);
+
+        for (i = 0;  i < disconnectedCount;  i++)
+        {
+            if (disconnected[i])
+                _glfwInputMonitor(disconnected[i], GLFW_DISCONNECTED, 0);
+        }
+
+        free(disconnected);
+    }
+
+    if (!_glfw.monitorCount)
+        connectPlaceholder();
+}
+
+// Records the latest change of an output, replacing any earlier change
+//
+void _glfwInputOutputChangeX11(const XRROutputChangeNotifyEvent* event)
+{
+    int i;
+
+    for (i = 0;  i < _glfw.x11.randr.outputChangeCount;  i++)
+    {
+        if (_glfw.x11.randr.outputChanges[i].output == event->output)
+        {
+            _glfw.x11.randr.outputChanges[i] = *event;
+            return;
+        }
+    }
+
+    _glfw.x11.randr.outputChanges =
+        realloc(_glfw.x11.randr.outputChanges,
+                sizeof(XRROutputChangeNotifyEvent) *
+                (_glfw.x11.randr.outputChangeCount + 1));
+    _glfw.x11.randr.outputChanges[_glfw.x11.randr.outputChangeCount++] = *event;
+}
+
+// Connects and disconnects monitors for the recorded output changes
+//
+void _glfwUpdateMonitorsX11(void)
+{
+    int i, j, screenCount = 0;
+    XRRScreenResources* sr = NULL;
+    XineramaScreenInfo* screens = NULL;
+    RROutput primary = None;
+
+    if (!_glfw.x11.randr.available || _glfw.x11.randr.monitorBroken)
+    {
+        _glfw.x11.randr.outputChangeCount = 0;
+        return;
+    }
+
+    for (i = 0;  i < _glfw.x11.randr.outputChangeCount;  i++)
+    {
+        const XRROutputChangeNotifyEvent* change =
+            _glfw.x11.randr.outputChanges + i;
+        const GLFWbool connected = change->connection == RR_Connected &&
+                                   change->crtc != None;
+        _GLFWmonitor* monitor = NULL;
+
+        for (j = 0;  j < _glfw.monitorCount;  j++)
+        {
+            if (_glfw.monitors[j]->x11.output == change->output)
             {
-                widthMM  = oi->mm_height;
-                heightMM = oi->mm_width;
+                monitor = _glfw.monitors[j];
+                break;
             }
+        }
+
+        if (monitor)
+        {
+            if (connected)
+                monitor->x11.crtc = change->crtc;
             else
+                _glfwInputMonitor(monitor, GLFW_DISCONNECTED, 0);
+        }
+        else if (connected)
+        {
+            // Only newly connected outputs need any information from the server
+            if (!sr)
             {
-                widthMM  = oi->mm_width;
-                heightMM = oi->mm_height;
-            }
-
-            monitor = _glfwAllocMonitor(oi->name, widthMM, heightMM);
-            monitor->x11.output = sr->outputs[i];
-            monitor->x11.crtc   = oi->crtc;
+                sr = XRRGetScreenResourcesCurrent(_glfw.x11.display,
+                                                  _glfw.x11.root);
+                primary = XRRGetOutputPrimary(_glfw.x11.display,
+                                              _glfw.x11.root);
 
-            for (j = 0;  j < screenCount;  j++)
-            {
-                if (screens[j].x_org == ci->x &&
-                    screens[j].y_org == ci->y &&
-                    screens[j].width == ci->width &&
-                    screens[j].height == ci->height)
+                if (_glfw.x11.xinerama.available)
                 {
-                    monitor->x11.index = j;
-                    break;
+                    screens = XineramaQueryScreens(_glfw.x11.display,
+                                                   &screenCount);
                 }
             }
 
-            if (monitor->x11.output == primary)
-                type = _GLFW_INSERT_FIRST;
-            else
-                type = _GLFW_INSERT_LAST;
-
-            _glfwInputMonitor(monitor, GLFW_CONNECTED, type);
-
-            XRRFreeOutputInfo(oi);
-            XRRFreeCrtcInfo(ci);
+            connectOutput(sr, change->output, primary, screens, screenCount);
         }
+    }
 
-        XRRFreeScreenResources(sr);
+    _glfw.x11.randr.outputChangeCount = 0;
 
-        if (screens)
-            XFree(screens);
+    if (sr)
+        XRRFreeScreenResources(sr);
+    if (screens)
+        XFree(screens);
 
-        for (i = 0;  i < disconnectedCount;  i++)
+    // Replace the placeholder monitor once an output is connected
+    for (i = 0;  i < _glfw.monitorCount && _glfw.monitorCount > 1;  i++)
+    {
+        if (_glfw.monitors[i]->x11.output == None)
         {
-            if (disconnected[i])
-                _glfwInputMonitor(disconnected[i], GLFW_DISCONNECTED, 0);
+            _glfwInputMonitor(_glfw.monitors[i], GLFW_DISCONNECTED, 0);
+            break;
         }
-
-        free(disconnected);
     }
 
     if (!_glfw.monitorCount)
+        connectPlaceholder();
+}
+
+// Discards the cached CRTC state and applied gamma ramp of all monitors
+//
+void _glfwInvalidateMonitorsX11(void)
+{
+    int i;
+
+    for (i = 0;  i < _glfw.monitorCount;  i++)
     {
-        const int widthMM = DisplayWidthMM(_glfw.x11.display, _glfw.x11.screen);
-        const int heightMM = DisplayHeightMM(_glfw.x11.display, _glfw.x11.screen);
+        _glfw.monitors[i]->x11.crtcStateValid = GLFW_FALSE;
 
-        _glfwInputMonitor(_glfwAllocMonitor("Display", widthMM, heightMM),
-                          GLFW_CONNECTED,
-                          _GLFW_INSERT_FIRST);
+        // A CRTC change may have reset the gamma ramp of the monitor
+        _glfwFreeGammaArrays(&_glfw.monitors[i]->appliedRamp);
     }
 }
 
@@ -265,6 +434,8 @@ GLFWbool _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired)
                              ci->rotation,
                              ci->outputs,
                              ci->noutput);
+
+            monitor->x11.crtcStateValid = GLFW_FALSE;
         }
 
         XRRFreeOutputInfo(oi);
@@ -310,6 +481,7 @@ void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor)
         XRRFreeScreenResources(sr);
 
         monitor->x11.oldMode = None;
+        monitor->x11.crtcStateValid = GLFW_FALSE;
     }
 }
 
@@ -322,19 +494,12 @@ void _glfwPlatformGetMonitorPos(_GLFWmonitor* monitor, int* xpos, int* ypos)
 {
     if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
     {
-        XRRScreenResources* sr;
-        XRRCrtcInfo* ci;
-
-        sr = XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
-        ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
+        refreshCrtcState(monitor);
 
         if (xpos)
-            *xpos = ci->x;
+            *xpos = monitor->x11.xpos;
         if (ypos)
-            *ypos = ci->y;
-
-        XRRFreeCrtcInfo(ci);
-        XRRFreeScreenResources(sr);
+            *ypos = monitor->x11.ypos;
     }
 }
 
@@ -346,7 +511,7 @@ GLFWvidmode* _glfwPlatformGetVideoModes(_GLFWmonitor* monitor, int* count)
 
     if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
     {
-        int i, j;
+        int i, modeCount = 0;
         XRRScreenResources* sr;
         XRRCrtcInfo* ci;
         XRROutputInfo* oi;
@@ -363,20 +528,21 @@ GLFWvidmode* _glfwPlatformGetVideoModes(_GLFWmonitor* monitor, int* count)
             if (!modeIsGood(mi))
                 continue;
 
-            const GLFWvidmode mode = vidmodeFromModeInfo(mi, ci);
+            result[modeCount++] = vidmodeFromModeInfo(mi, ci);
+        }
 
-            for (j = 0;  j < *count;  j++)
-            {
-                if (_glfwCompareVideoModes(result + j, &mode) == 0)
-                    break;
-            }
+        // Sort the modes so that duplicates are adjacent and skip them
+        qsort(result, modeCount, sizeof(GLFWvidmode), compareVideoModes);
 
-            // Skip duplicate modes
-            if (j < *count)
+        for (i = 0;  i < modeCount;  i++)
+        {
+            if (*count && _glfwCompareVideoModes(result + *count - 1,
+                                                 result + i) == 0)
+            {
                 continue;
+            }
 
-            (*count)++;
-            result[*count - 1] = mode;
+            result[(*count)++] = result[i];
         }
 
         XRRFreeOutputInfo(oi);
@@ -397,16 +563,8 @@ void _glfwPlatformGetVideoMode(_GLFWmonitor* monitor, GLFWvidmode* mode)
 {
     if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
     {
-        XRRScreenResources* sr;
-        XRRCrtcInfo* ci;
-
-        sr = XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
-        ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
-
-        *mode = vidmodeFromModeInfo(getModeInfo(sr, ci->mode), ci);
-
-        XRRFreeCrtcInfo(ci);
-        XRRFreeScreenResources(sr);
+        refreshCrtcState(monitor);
+        *mode = monitor->x11.currentMode;
     }
     else
     {
@@ -449,7 +607,7 @@ void _glfwPlatformGetGammaRamp(_GLFWmonitor* monitor, GLFWgammaramp* ramp)
     }
 }
 
-void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
+GLFWbool _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
 {
     if (_glfw.x11.randr.available && !_glfw.x11.randr.gammaBroken)
     {
@@ -457,7 +615,7 @@ void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
         {
             _glfwInputError(GLFW_PLATFORM_ERROR,
                             "X11: Gamma ramp size must match current ramp size");
-            return;
+            return GLFW_FALSE;
         }
 
         XRRCrtcGamma* gamma = XRRAllocGamma(ramp->size);
@@ -468,6 +626,7 @@ void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
 
         XRRSetCrtcGamma(_glfw.x11.display, monitor->x11.crtc, gamma);
         XRRFreeGamma(gamma);
+        return GLFW_TRUE;
     }
     else if (_glfw.x11.vidmode.available)
     {
@@ -477,7 +636,10 @@ void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
                                 (unsigned short*) ramp->red,
                                 (unsigned short*) ramp->green,
                                 (unsigned short*) ramp->blue);
+        return GLFW_TRUE;
     }
+
+    return GLFW_FALSE;
 }
 
 
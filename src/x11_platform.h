@@ -52,6 +52,156 @@ typedef XID xcb_visualid_t;
 typedef struct xcb_connection_t xcb_connection_t;
 typedef xcb_connection_t* (* PFN_XGetXCBConnection)(Display*);
 
+typedef struct xcb_generic_error_t xcb_generic_error_t;
+
+typedef struct xcb_query_extension_cookie_t
+{
+    unsigned int    sequence;
+} xcb_query_extension_cookie_t;
+
+typedef struct xcb_query_extension_reply_t
+{
+    uint8_t         response_type;
+    uint8_t         pad0;
+    uint16_t        sequence;
+    uint32_t        length;
+    uint8_t         present;
+    uint8_t         major_opcode;
+    uint8_t         first_event;
+    uint8_t         first_error;
+} xcb_query_extension_reply_t;
+
+typedef xcb_query_extension_cookie_t (* PFN_xcb_query_extension)(xcb_connection_t*,uint16_t,const char*);
+typedef xcb_query_extension_reply_t* (* PFN_xcb_query_extension_reply)(xcb_connection_t*,xcb_query_extension_cookie_t,xcb_generic_error_t**);
+#define xcb_query_extension _glfw.x11.xcb.query_extension
+#define xcb_query_extension_reply _glfw.x11.xcb.query_extension_reply
+
+// NOTE: Window and atom IDs are 32-bit on the wire, unlike XID and Atom
+typedef struct xcb_get_property_cookie_t
+{
+    unsigned int    sequence;
+} xcb_get_property_cookie_t;
+
+typedef struct xcb_get_property_reply_t
+{
+    uint8_t         response_type;
+    uint8_t         format;
+    uint16_t        sequence;
+    uint32_t        length;
+    uint32_t        type;
+    uint32_t        bytes_after;
+    uint32_t        value_len;
+    uint8_t         pad0[12];
+} xcb_get_property_reply_t;
+
+typedef struct xcb_query_pointer_cookie_t
+{
+    unsigned int    sequence;
+} xcb_query_pointer_cookie_t;
+
+typedef struct xcb_query_pointer_reply_t
+{
+    uint8_t         response_type;
+    uint8_t         same_screen;
+    uint16_t        sequence;
+    uint32_t        length;
+    uint32_t        root;
+    uint32_t        child;
+    int16_t         root_x;
+    int16_t         root_y;
+    int16_t         win_x;
+    int16_t         win_y;
+    uint16_t        mask;
+    uint8_t         pad0[2];
+} xcb_query_pointer_reply_t;
+
+typedef struct xcb_translate_coordinates_cookie_t
+{
+    unsigned int    sequence;
+} xcb_translate_coordinates_cookie_t;
+
+typedef struct xcb_translate_coordinates_reply_t
+{
+    uint8_t         response_type;
+    uint8_t         same_screen;
+    uint16_t        sequence;
+    uint32_t        length;
+    uint32_t        child;
+    int16_t         dst_x;
+    int16_t         dst_y;
+} xcb_translate_coordinates_reply_t;
+
+typedef struct xcb_get_geometry_cookie_t
+{
+    unsigned int    sequence;
+} xcb_get_geometry_cookie_t;
+
+typedef struct xcb_get_geometry_reply_t
+{
+    uint8_t         response_type;
+    uint8_t         depth;
+    uint16_t        sequence;
+    uint32_t        length;
+    uint32_t        root;
+    int16_t         x;
+    int16_t         y;
+    uint16_t        width;
+    uint16_t        height;
+    uint16_t        border_width;
+    uint8_t         pad0[2];
+} xcb_get_geometry_reply_t;
+
+typedef struct xcb_get_window_attributes_cookie_t
+{
+    unsigned int    sequence;
+} xcb_get_window_attributes_cookie_t;
+
+typedef struct xcb_get_window_attributes_reply_t
+{
+    uint8_t         response_type;
+    uint8_t         backing_store;
+    uint16_t        sequence;
+    uint32_t        length;
+    uint32_t        visual;
+    uint16_t        _class;
+    uint8_t         bit_gravity;
+    uint8_t         win_gravity;
+    uint32_t        backing_planes;
+    uint32_t        backing_pixel;
+    uint8_t         save_under;
+    uint8_t         map_is_installed;
+    uint8_t         map_state;
+    uint8_t         override_redirect;
+    uint32_t        colormap;
+    uint32_t        all_event_masks;
+    uint32_t        your_event_mask;
+    uint16_t        do_not_propagate_mask;
+    uint8_t         pad1[2];
+} xcb_get_window_attributes_reply_t;
+
+typedef xcb_get_property_cookie_t (* PFN_xcb_get_property)(xcb_connection_t*,uint8_t,uint32_t,uint32_t,uint32_t,uint32_t,uint32_t);
+typedef xcb_get_property_reply_t* (* PFN_xcb_get_property_reply)(xcb_connection_t*,xcb_get_property_cookie_t,xcb_generic_error_t**);
+typedef void* (* PFN_xcb_get_property_value)(const xcb_get_property_reply_t*);
+typedef xcb_query_pointer_cookie_t (* PFN_xcb_query_pointer)(xcb_connection_t*,uint32_t);
+typedef xcb_query_pointer_reply_t* (* PFN_xcb_query_pointer_reply)(xcb_connection_t*,xcb_query_pointer_cookie_t,xcb_generic_error_t**);
+typedef xcb_translate_coordinates_cookie_t (* PFN_xcb_translate_coordinates)(xcb_connection_t*,uint32_t,uint32_t,int16_t,int16_t);
+typedef xcb_translate_coordinates_reply_t* (* PFN_xcb_translate_coordinates_reply)(xcb_connection_t*,xcb_translate_coordinates_cookie_t,xcb_generic_error_t**);
+typedef xcb_get_geometry_cookie_t (* PFN_xcb_get_geometry)(xcb_connection_t*,uint32_t);
+typedef xcb_get_geometry_reply_t* (* PFN_xcb_get_geometry_reply)(xcb_connection_t*,xcb_get_geometry_cookie_t,xcb_generic_error_t**);
+typedef xcb_get_window_attributes_cookie_t (* PFN_xcb_get_window_attributes)(xcb_connection_t*,uint32_t);
+typedef xcb_get_window_attributes_reply_t* (* PFN_xcb_get_window_attributes_reply)(xcb_connection_t*,xcb_get_window_attributes_cookie_t,xcb_generic_error_t**);
+#define xcb_get_property _glfw.x11.xcb.get_property
+#define xcb_get_property_reply _glfw.x11.xcb.get_property_reply
+#define xcb_get_property_value _glfw.x11.xcb.get_property_value
+#define xcb_query_pointer _glfw.x11.xcb.query_pointer
+#define xcb_query_pointer_reply _glfw.x11.xcb.query_pointer_reply
+#define xcb_translate_coordinates _glfw.x11.xcb.translate_coordinates
+#define xcb_translate_coordinates_reply _glfw.x11.xcb.translate_coordinates_reply
+#define xcb_get_geometry _glfw.x11.xcb.get_geometry
+#define xcb_get_geometry_reply _glfw.x11.xcb.get_geometry_reply
+#define xcb_get_window_attributes _glfw.x11.xcb.get_window_attributes
+#define xcb_get_window_attributes_reply _glfw.x11.xcb.get_window_attributes_reply
+
 typedef Bool (* PFN_XF86VidModeQueryExtension)(Display*,int*,int*);
 typedef Bool (* PFN_XF86VidModeGetGammaRamp)(Display*,int,int,unsigned short*,unsigned short*,unsigned short*);
 typedef Bool (* PFN_XF86VidModeSetGammaRamp)(Display*,int,int,unsigned short*,unsigned short*,unsigned short*);
@@ -132,17 +282,66 @@ typedef struct _GLFWwindowX11
     // Cached position and size used to filter out duplicate events
     int             width, height;
     int             xpos, ypos;
+    // Whether the cached size and position are known to be current
+    GLFWbool        sizeCached, posCached;
 
     // The last received cursor position, regardless of source
     int             lastCursorPosX, lastCursorPosY;
+    // Whether the last received cursor position is still current
+    GLFWbool        cursorTracked;
+    // Whether the cursor is inside the window, between crossing events
+    // Motion is also reported outside the window during a button grab
+    GLFWbool        cursorInside;
     // The last position the cursor was warped to by GLFW
     int             warpCursorPosX, warpCursorPosY;
 
     // The time of the last KeyPress event
     Time            lastKeyTime;
+    // Reusable buffer for input method text too long for the stack buffer
+    char*           text;
+    size_t          textSize;
 
 } _GLFWwindowX11;
 
+// X11-specific data for a selection sent in parts (ICCCM section 2.7.2)
+//
+typedef struct _GLFWincrX11
+{
+    Window          requestor;
+    Atom            property;
+    Atom            target;
+    const char*     data;
+    size_t          size;
+    size_t          offset;
+    double          deadline;
+    // Copy of the unsent data made when the selection changed, or NULL
+    char*           copy;
+} _GLFWincrX11;
+
+// X11-specific data for a server-side cursor shared by identical cursors
+//
+typedef struct _GLFWsharedcursorX11
+{
+    Cursor          handle;
+    int             refCount;
+    // Standard cursor shape, or zero for image cursors
+    int             shape;
+    // Hotspot, frame sizes, delays and premultiplied pixels of image cursors
+    uint32_t*       key;
+    size_t          keySize;
+    uint64_t        hash;
+} _GLFWsharedcursorX11;
+
+// X11-specific window property request, answered by XCB when available
+//
+typedef struct _GLFWpropertyrequestX11
+{
+    Window          window;
+    Atom            property;
+    Atom            type;
+    xcb_get_property_cookie_t cookie;
+} _GLFWpropertyrequestX11;
+
 // X11-specific global data
 //
 typedef struct _GLFWlibraryX11
@@ -155,6 +354,9 @@ typedef struct _GLFWlibraryX11
     Window          helperWindowHandle;
     // Invisible cursor for hidden cursor mode
     Cursor          hiddenCursorHandle;
+    // Server-side cursors shared by identical cursor objects
+    _GLFWsharedcursorX11** sharedCursors;
+    int             sharedCursorCount;
     // Context for mapping window XIDs to _GLFWwindow pointers
     XContext        context;
     // XIM input method
@@ -163,6 +365,31 @@ typedef struct _GLFWlibraryX11
     int             errorCode;
     // Clipboard string (while the selection is owned)
     char*           clipboardString;
+    // Length of the clipboard string and its conversion for STRING requests
+    size_t          clipboardLength;
+    char*           clipboardLatin1;
+    size_t          clipboardLatin1Length;
+    // Selections being sent in parts
+    _GLFWincrX11*   incrs;
+    int             incrCount;
+    // Target atoms of the offered clipboard types (while the selection is owned)
+    Atom*           clipboardTargets;
+    // Typed clipboard data and types received from the selection owner
+    char*           clipboardData;
+    size_t          clipboardDataSize;
+    char**          clipboardTypes;
+    int             clipboardTypeCount;
+    // Clipboard transfer in progress, if any
+    struct {
+        int         request;
+        int         state;
+        Atom        target;
+        char*       data;
+        size_t      size;
+        size_t      capacity;
+        double      deadline;
+        GLFWbool    blocking;
+    } transfer;
     // Key name string
     char            keyName[5];
     // X11 keycode to GLFW key LUT
@@ -173,8 +400,12 @@ typedef struct _GLFWlibraryX11
     double          restoreCursorPosX, restoreCursorPosY;
     // The window whose disabled cursor mode is active
     _GLFWwindow*    disabledCursorWindow;
+    // The window that has input focus, if any
+    _GLFWwindow*    focusedWindow;
 
     // Window manager atoms
+    Atom            NET_SUPPORTED;
+    Atom            NET_SUPPORTING_WM_CHECK;
     Atom            WM_PROTOCOLS;
     Atom            WM_STATE;
     Atom            WM_DELETE_WINDOW;
@@ -220,6 +451,7 @@ typedef struct _GLFWlibraryX11
     Atom            UTF8_STRING;
     Atom            COMPOUND_STRING;
     Atom            ATOM_PAIR;
+    Atom            INCR;
     Atom            GLFW_SELECTION;
 
     struct {
@@ -230,6 +462,9 @@ typedef struct _GLFWlibraryX11
         int         minor;
         GLFWbool    gammaBroken;
         GLFWbool    monitorBroken;
+        // Latest change of each output since the monitors were last updated
+        XRROutputChangeNotifyEvent* outputChanges;
+        int         outputChangeCount;
     } randr;
 
     struct {
@@ -267,6 +502,25 @@ typedef struct _GLFWlibraryX11
         PFN_XGetXCBConnection XGetXCBConnection;
     } x11xcb;
 
+    struct {
+        void*       handle;
+        // The XCB connection underlying the display, if XCB is available
+        xcb_connection_t* connection;
+        PFN_xcb_query_extension query_extension;
+        PFN_xcb_query_extension_reply query_extension_reply;
+        PFN_xcb_get_property get_property;
+        PFN_xcb_get_property_reply get_property_reply;
+        PFN_xcb_get_property_value get_property_value;
+        PFN_xcb_query_pointer query_pointer;
+        PFN_xcb_query_pointer_reply query_pointer_reply;
+        PFN_xcb_translate_coordinates translate_coordinates;
+        PFN_xcb_translate_coordinates_reply translate_coordinates_reply;
+        PFN_xcb_get_geometry get_geometry;
+        PFN_xcb_get_geometry_reply get_geometry_reply;
+        PFN_xcb_get_window_attributes get_window_attributes;
+        PFN_xcb_get_window_attributes_reply get_window_attributes_reply;
+    } xcb;
+
     struct {
         GLFWbool    available;
         void*       handle;
@@ -288,6 +542,11 @@ typedef struct _GLFWlibraryX11
         int         minor;
         PFN_XIQueryVersion QueryVersion;
         PFN_XISelectEvents SelectEvents;
+        // Raw motion samples not yet delivered and the window they are for
+        _GLFWwindow*   rawWindow;
+        GLFWrawmotion* rawSamples;
+        int            rawSampleCount;
+        int            rawSampleCapacity;
     } xi;
 
 } _GLFWlibraryX11;
@@ -304,6 +563,11 @@ typedef struct _GLFWmonitorX11
     // for EWMH full screen window placement
     int             index;
 
+    // CRTC position and current mode, cached until the next RandR notification
+    GLFWbool        crtcStateValid;
+    int             xpos, ypos;
+    GLFWvidmode     currentMode;
+
 } _GLFWmonitorX11;
 
 // X11-specific per-cursor data
@@ -311,11 +575,15 @@ typedef struct _GLFWmonitorX11
 typedef struct _GLFWcursorX11
 {
     Cursor handle;
+    _GLFWsharedcursorX11* shared;
 
 } _GLFWcursorX11;
 
 
 void _glfwPollMonitorsX11(void);
+void _glfwInvalidateMonitorsX11(void);
+void _glfwInputOutputChangeX11(const XRROutputChangeNotifyEvent* event);
+void _glfwUpdateMonitorsX11(void);
 GLFWbool _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired);
 void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor);
 
@@ -325,6 +593,12 @@ unsigned long _glfwGetWindowPropertyX11(Window window,
                                         Atom property,
                                         Atom type,
                                         unsigned char** value);
+void _glfwRequestWindowPropertyX11(_GLFWpropertyrequestX11* request,
+                                   Window window,
+                                   Atom property,
+                                   Atom type);
+unsigned long _glfwReadWindowPropertyX11(_GLFWpropertyrequestX11* request,
+                                         unsigned char** value);
 
 void _glfwGrabErrorHandlerX11(void);
 void _glfwReleaseErrorHandlerX11(void);
@@ -50,6 +50,22 @@
 
 #define _GLFW_XDND_VERSION 5
 
+// Clipboard transfer states
+#define _GLFW_TRANSFER_NONE    0
+#define _GLFW_TRANSFER_TARGETS 1
+#define _GLFW_TRANSFER_DATA    2
+#define _GLFW_TRANSFER_INCR    3
+
+// Clipboard transfer requests
+#define _GLFW_REQUEST_STRING   0
+#define _GLFW_REQUEST_TYPES    1
+#define _GLFW_REQUEST_DATA     2
+
+// Largest part of the selection sent in a single property write
+#define _GLFW_INCR_CHUNK_SIZE  (1 << 20)
+// Largest size hint of an incoming INCR transfer reserved up front
+#define _GLFW_INCR_HINT_LIMIT  (4 << 20)
+
 
 // Wait for data to arrive using select
 // This avoids blocking other threads via the per-display Xlib lock that also
@@ -187,6 +203,227 @@ static int translateCursorShape(int shape)
     return 0;
 }
 
+// Returns the FNV-1a hash of the specified cursor key
+//
+static uint64_t hashCursorKey(const uint32_t* key, size_t keySize)
+{
+    size_t i;
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (i = 0;  i < keySize;  i++)
+    {
+        hash ^= key[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+// Returns the shared cursor with the specified shape or key, if any
+//
+static _GLFWsharedcursorX11* findSharedCursor(int shape,
+                                              const uint32_t* key,
+                                              size_t keySize,
+                                              uint64_t hash)
+{
+    int i;
+
+    for (i = 0;  i < _glfw.x11.sharedCursorCount;  i++)
+    {
+        _GLFWsharedcursorX11* shared = _glfw.x11.sharedCursors[i];
+
+        if (shared->shape != shape ||
+            shared->hash != hash ||
+            shared->keySize != keySize)
+        {
+            continue;
+        }
+
+        if (keySize && memcmp(shared->key, key, keySize * sizeof(uint32_t)))
+            continue;
+
+        return shared;
+    }
+
+    return NULL;
+}
+
+// Adds a shared cursor for the specified server-side cursor
+// The shared cursor takes ownership of the key, which is freed on failure
+//
+static _GLFWsharedcursorX11* addSharedCursor(Cursor handle,
+                                             int shape,
+                                             uint32_t* key,
+                                             size_t keySize,
+                                             uint64_t hash)
+{
+    _GLFWsharedcursorX11** cursors;
+    _GLFWsharedcursorX11* shared = calloc(1, sizeof(_GLFWsharedcursorX11));
+    if (!shared)
+    {
+        free(key);
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return NULL;
+    }
+
+    shared->handle = handle;
+    shared->refCount = 1;
+    shared->shape = shape;
+    shared->key = key;
+    shared->keySize = keySize;
+    shared->hash = hash;
+
+    cursors = realloc(_glfw.x11.sharedCursors,
+                      sizeof(_GLFWsharedcursorX11*) *
+                      (_glfw.x11.sharedCursorCount + 1));
+    if (!cursors)
+    {
+        // The cursor is still usable but later identical cursors will not
+        // find it, and releasing it does not depend on the cache
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return shared;
+    }
+
+    _glfw.x11.sharedCursors = cursors;
+    _glfw.x11.sharedCursors[_glfw.x11.sharedCursorCount++] = shared;
+
+    return shared;
+}
+
+// Releases a reference to a shared cursor, freeing it after the last one
+//
+static void releaseSharedCursor(_GLFWsharedcursorX11* shared)
+{
+    int i;
+
+    if (--shared->refCount > 0)
+        return;
+
+    for (i = 0;  i < _glfw.x11.sharedCursorCount;  i++)
+    {
+        if (_glfw.x11.sharedCursors[i] == shared)
+        {
+            _glfw.x11.sharedCursors[i] =
+                _glfw.x11.sharedCursors[--_glfw.x11.sharedCursorCount];
+            break;
+        }
+    }
+
+    XFreeCursor(_glfw.x11.display, shared->handle);
+    free(shared->key);
+    free(shared);
+}
+
+// Creates a server-side cursor from the frames described by a cursor key
+//
+static Cursor createCursorFromKey(const uint32_t* key)
+{
+    int i;
+    Cursor handle;
+    const int count = (int) key[2];
+    const uint32_t* frame = key + 3;
+
+    XcursorImages* images = XcursorImagesCreate(count);
+    if (!images)
+        return None;
+
+    for (i = 0;  i < count;  i++)
+    {
+        const int width = (int) frame[0];
+        const int height = (int) frame[1];
+        XcursorImage* image = XcursorImageCreate(width, height);
+        if (!image)
+        {
+            XcursorImagesDestroy(images);
+            return None;
+        }
+
+        image->xhot = key[0];
+        image->yhot = key[1];
+        image->delay = frame[2];
+        memcpy(image->pixels, frame + 3,
+               (size_t) width * height * sizeof(XcursorPixel));
+
+        images->images[images->nimage++] = image;
+        frame += 3 + (size_t) width * height;
+    }
+
+    handle = XcursorImagesLoadCursor(_glfw.x11.display, images);
+    XcursorImagesDestroy(images);
+
+    return handle;
+}
+
+// Creates or reuses a server-side cursor for the specified frames
+//
+static GLFWbool createImageCursor(_GLFWcursor* cursor,
+                                  const GLFWimage* frames,
+                                  const int* delays,
+                                  int count,
+                                  int xhot, int yhot)
+{
+    int i;
+    uint32_t* key;
+    uint32_t* target;
+    uint64_t hash;
+    size_t keySize = 3;
+    _GLFWsharedcursorX11* shared;
+
+    // The key holds the hotspot and frame count, followed by the size, delay
+    // and premultiplied pixels of each frame in the order used by Xcursor
+    for (i = 0;  i < count;  i++)
+        keySize += 3 + (size_t) frames[i].width * frames[i].height;
+
+    key = calloc(keySize, sizeof(uint32_t));
+    key[0] = (uint32_t) xhot;
+    key[1] = (uint32_t) yhot;
+    key[2] = (uint32_t) count;
+
+    target = key + 3;
+
+    for (i = 0;  i < count;  i++)
+    {
+        const size_t pixelCount = (size_t) frames[i].width * frames[i].height;
+
+        target[0] = (uint32_t) frames[i].width;
+        target[1] = (uint32_t) frames[i].height;
+        target[2] = delays ? (uint32_t) delays[i] : 0;
+        _glfwConvertToPremultipliedARGB(target + 3, frames[i].pixels, pixelCount);
+        target += 3 + pixelCount;
+    }
+
+    hash = hashCursorKey(key, keySize);
+
+    shared = findSharedCursor(0, key, keySize, hash);
+    if (shared)
+    {
+        shared->refCount++;
+        free(key);
+    }
+    else
+    {
+        const Cursor handle = createCursorFromKey(key);
+        if (!handle)
+        {
+            free(key);
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "X11: Failed to create custom cursor");
+            return GLFW_FALSE;
+        }
+
+        shared = addSharedCursor(handle, 0, key, keySize, hash);
+        if (!shared)
+        {
+            XFreeCursor(_glfw.x11.display, handle);
+            return GLFW_FALSE;
+        }
+    }
+
+    cursor->x11.shared = shared;
+    cursor->x11.handle = shared->handle;
+    return GLFW_TRUE;
+}
+
 // Translates an X event modifier state mask
 //
 static int translateState(int state)
@@ -479,6 +716,89 @@ static void updateCursorImage(_GLFWwindow* window)
     }
 }
 
+// Selects raw motion events on the root window while any window needs them
+//
+static void updateRawMotionSelection(void)
+{
+    XIEventMask em;
+    unsigned char mask[XIMaskLen(XI_RawMotion)] = { 0 };
+    _GLFWwindow* window;
+
+    if (!_glfw.x11.xi.available)
+        return;
+
+    if (_glfw.x11.disabledCursorWindow)
+        XISetMask(mask, XI_RawMotion);
+
+    for (window = _glfw.windowListHead;  window;  window = window->next)
+    {
+        if (window->rawMouseMotion)
+            XISetMask(mask, XI_RawMotion);
+    }
+
+    em.deviceid = XIAllMasterDevices;
+    em.mask_len = sizeof(mask);
+    em.mask = mask;
+
+    XISelectEvents(_glfw.x11.display, _glfw.x11.root, &em, 1);
+}
+
+// Delivers the raw motion samples received since the last call
+//
+static void flushRawMotion(void)
+{
+    _GLFWwindow* window = _glfw.x11.xi.rawWindow;
+    const int count = _glfw.x11.xi.rawSampleCount;
+
+    _glfw.x11.xi.rawWindow = NULL;
+    _glfw.x11.xi.rawSampleCount = 0;
+
+    if (window && count)
+        _glfwInputRawMotion(window, _glfw.x11.xi.rawSamples, count);
+}
+
+// Stores a raw motion sample for the focused window, if it wants them
+//
+static void queueRawMotion(double dx, double dy, Time time)
+{
+    GLFWrawmotion* sample;
+    _GLFWwindow* window = _glfw.x11.focusedWindow;
+
+    if (!window || !window->rawMouseMotion)
+        return;
+
+    if (_glfw.x11.xi.rawWindow != window)
+    {
+        flushRawMotion();
+        _glfw.x11.xi.rawWindow = window;
+    }
+
+    if (_glfw.x11.xi.rawSampleCount == _glfw.x11.xi.rawSampleCapacity)
+    {
+        GLFWrawmotion* samples;
+        int capacity = _glfw.x11.xi.rawSampleCapacity * 2;
+        if (capacity < 64)
+            capacity = 64;
+
+        samples = realloc(_glfw.x11.xi.rawSamples,
+                          capacity * sizeof(GLFWrawmotion));
+        if (!samples)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY,
+                            "X11: Failed to allocate raw motion samples");
+            return;
+        }
+
+        _glfw.x11.xi.rawSamples = samples;
+        _glfw.x11.xi.rawSampleCapacity = capacity;
+    }
+
+    sample = _glfw.x11.xi.rawSamples + _glfw.x11.xi.rawSampleCount++;
+    sample->dx = dx;
+    sample->dy = dy;
+    sample->time = time / 1000.0;
+}
+
 // Create the X11 window (and its colormap)
 //
 static GLFWbool createNativeWindow(_GLFWwindow* window,
@@ -650,155 +970,537 @@ static GLFWbool createNativeWindow(_GLFWwindow* window,
 
     _glfwPlatformGetWindowPos(window, &window->x11.xpos, &window->x11.ypos);
     _glfwPlatformGetWindowSize(window, &window->x11.width, &window->x11.height);
+    window->x11.posCached = GLFW_TRUE;
+    window->x11.sizeCached = GLFW_TRUE;
 
     return GLFW_TRUE;
 }
 
-// Set the specified property to the selection converted to the requested target
+// Returns the timer value in seconds, for clipboard transfer deadlines
 //
-static Atom writeTargetToProperty(const XSelectionRequestEvent* request)
+static double getTransferTime(void)
 {
-    int i;
-    const Atom formats[] = { _glfw.x11.UTF8_STRING,
-                             _glfw.x11.COMPOUND_STRING,
-                             XA_STRING };
-    const int formatCount = sizeof(formats) / sizeof(formats[0]);
+    return _glfwPlatformGetTimerValue() /
+        (double) _glfwPlatformGetTimerFrequency();
+}
 
-    if (request->property == None)
-    {
-        // The requester is a legacy client (ICCCM section 2.2)
-        // We don't support legacy clients, so fail here
-        return None;
-    }
+// Returns the largest property that can be written with a single request
+//
+static size_t getMaxPropertySize(void)
+{
+    long size = XExtendedMaxRequestSize(_glfw.x11.display);
+    if (!size)
+        size = XMaxRequestSize(_glfw.x11.display);
 
-    if (request->target == _glfw.x11.TARGETS)
-    {
-        // The list of supported targets was requested
+    // The size is in four byte units and includes the request header
+    size = size * 4 - 64;
 
-        const Atom targets[] = { _glfw.x11.TARGETS,
-                                 _glfw.x11.MULTIPLE,
-                                 _glfw.x11.UTF8_STRING,
-                                 _glfw.x11.COMPOUND_STRING,
-                                 XA_STRING };
+    if (size > _GLFW_INCR_CHUNK_SIZE)
+        return _GLFW_INCR_CHUNK_SIZE;
 
-        XChangeProperty(_glfw.x11.display,
-                        request->requestor,
-                        request->property,
-                        XA_ATOM,
-                        32,
-                        PropModeReplace,
-                        (unsigned char*) targets,
-                        sizeof(targets) / sizeof(targets[0]));
+    return (size_t) size;
+}
 
-        return request->property;
+// Converts a UTF-8 string to Latin-1, replacing characters outside it
+//
+static char* convertLatin1(const char* source, size_t length, size_t* size)
+{
+    size_t i, count = 0;
+    char* target = malloc(length + 1);
+    if (!target)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return NULL;
     }
 
-    if (request->target == _glfw.x11.MULTIPLE)
+    for (i = 0;  i < length;  count++)
     {
-        // Multiple conversions were requested
+        const unsigned char c = (unsigned char) source[i++];
 
-        Atom* targets;
-        unsigned long i, count;
+        if (c < 0x80)
+            target[count] = (char) c;
+        else if ((c == 0xc2 || c == 0xc3) &&
+                 i < length && ((unsigned char) source[i] & 0xc0) == 0x80)
+        {
+            target[count] = (char) (((c & 0x1f) << 6) |
+                                    ((unsigned char) source[i++] & 0x3f));
+        }
+        else
+        {
+            while (i < length && ((unsigned char) source[i] & 0xc0) == 0x80)
+                i++;
 
-        count = _glfwGetWindowPropertyX11(request->requestor,
-                                          request->property,
-                                          _glfw.x11.ATOM_PAIR,
-                                          (unsigned char**) &targets);
+            target[count] = '?';
+        }
+    }
 
-        for (i = 0;  i < count;  i += 2)
-        {
-            int j;
+    target[count] = '\0';
+    *size = count;
+    return target;
+}
 
-            for (j = 0;  j < formatCount;  j++)
-            {
-                if (targets[i] == formats[j])
-                    break;
-            }
+// Returns the clipboard contents converted to the specified target
+// Conversions are cached until the clipboard contents change
+//
+static const char* getSelectionData(Atom target, size_t* size)
+{
+    if (!_glfw.x11.clipboardString)
+    {
+        int i;
 
-            if (j < formatCount)
+        for (i = 0;  i < _glfw.clipboard.count;  i++)
+        {
+            if (_glfw.x11.clipboardTargets[i] == target)
             {
-                XChangeProperty(_glfw.x11.display,
-                                request->requestor,
-                                targets[i + 1],
-                                targets[i],
-                                8,
-                                PropModeReplace,
-                                (unsigned char*) _glfw.x11.clipboardString,
-                                strlen(_glfw.x11.clipboardString));
+                return _glfwGetOfferedClipboardData(_glfw.clipboard.names[i],
+                                                    size);
             }
-            else
-                targets[i + 1] = None;
         }
 
-        XChangeProperty(_glfw.x11.display,
-                        request->requestor,
-                        request->property,
-                        _glfw.x11.ATOM_PAIR,
-                        32,
-                        PropModeReplace,
-                        (unsigned char*) targets,
-                        count);
-
-        XFree(targets);
-
-        return request->property;
+        return NULL;
     }
 
-    if (request->target == _glfw.x11.SAVE_TARGETS)
+    if (target == XA_STRING)
     {
-        // The request is a check whether we support SAVE_TARGETS
-        // It should be handled as a no-op side effect target
+        if (!_glfw.x11.clipboardLatin1)
+        {
+            _glfw.x11.clipboardLatin1 =
+                convertLatin1(_glfw.x11.clipboardString,
+                              _glfw.x11.clipboardLength,
+                              &_glfw.x11.clipboardLatin1Length);
+        }
 
-        XChangeProperty(_glfw.x11.display,
-                        request->requestor,
-                        request->property,
-                        _glfw.x11.NULL_,
-                        32,
-                        PropModeReplace,
-                        NULL,
-                        0);
+        *size = _glfw.x11.clipboardLatin1Length;
+        return _glfw.x11.clipboardLatin1;
+    }
 
-        return request->property;
+    if (target == _glfw.x11.UTF8_STRING || target == _glfw.x11.COMPOUND_STRING)
+    {
+        *size = _glfw.x11.clipboardLength;
+        return _glfw.x11.clipboardString;
     }
 
-    // Conversion to a data target was requested
+    return NULL;
+}
+
+// Returns the incremental selection transfer to the specified property, if any
+//
+static _GLFWincrX11* findIncr(Window requestor, Atom property)
+{
+    int i;
 
-    for (i = 0;  i < formatCount;  i++)
+    for (i = 0;  i < _glfw.x11.incrCount;  i++)
     {
-        if (request->target == formats[i])
+        if (_glfw.x11.incrs[i].requestor == requestor &&
+            _glfw.x11.incrs[i].property == property)
         {
-            // The requested target is one we support
-
-            XChangeProperty(_glfw.x11.display,
-                            request->requestor,
-                            request->property,
-                            request->target,
-                            8,
-                            PropModeReplace,
-                            (unsigned char*) _glfw.x11.clipboardString,
-                            strlen(_glfw.x11.clipboardString));
-
-            return request->property;
+            return _glfw.x11.incrs + i;
         }
     }
 
-    // The requested target is not supported
+    return NULL;
+}
+
+// Returns whether the event is the requestor deleting a part of an incremental
+// selection transfer
+//
+static Bool isIncrEvent(Display* display, XEvent* event, XPointer pointer)
+{
+    if (event->type != PropertyNotify ||
+        event->xproperty.state != PropertyDelete)
+    {
+        return False;
+    }
 
-    return None;
+    return findIncr(event->xproperty.window, event->xproperty.atom) != NULL;
 }
 
-static void handleSelectionClear(XEvent* event)
+// Returns whether the window belongs to GLFW and so already selects property
+// change events
+//
+static GLFWbool isOwnWindow(Window handle)
 {
-    free(_glfw.x11.clipboardString);
-    _glfw.x11.clipboardString = NULL;
+    return handle == _glfw.x11.helperWindowHandle ||
+           findWindowByHandle(handle) != NULL;
 }
 
-static void handleSelectionRequest(XEvent* event)
+// Removes an incremental selection transfer
+//
+static void removeIncr(_GLFWincrX11* incr, GLFWbool completed)
 {
-    const XSelectionRequestEvent* request = &event->xselectionrequest;
+    const Window requestor = incr->requestor;
 
-    XEvent reply;
-    memset(&reply, 0, sizeof(reply));
+    free(incr->copy);
+    *incr = _glfw.x11.incrs[--_glfw.x11.incrCount];
+
+    // The requestor window may have been destroyed if the transfer did not
+    // complete, so its event mask is only restored after completion
+    if (completed && !isOwnWindow(requestor))
+    {
+        int i;
+
+        for (i = 0;  i < _glfw.x11.incrCount;  i++)
+        {
+            if (_glfw.x11.incrs[i].requestor == requestor)
+                return;
+        }
+
+        XSelectInput(_glfw.x11.display, requestor, NoEventMask);
+    }
+}
+
+// Makes unfinished incremental selection transfers independent of the selection
+// data, so they can be completed after it has changed or been freed
+//
+static void detachIncrs(void)
+{
+    int i;
+
+    for (i = _glfw.x11.incrCount - 1;  i >= 0;  i--)
+    {
+        _GLFWincrX11* incr = _glfw.x11.incrs + i;
+        const size_t size = incr->size - incr->offset;
+        char* copy;
+
+        if (incr->copy)
+            continue;
+
+        copy = malloc(size + 1);
+        if (!copy)
+        {
+            // End the transfer early rather than leave the requestor waiting
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+
+            _glfwGrabErrorHandlerX11();
+            XChangeProperty(_glfw.x11.display,
+                            incr->requestor,
+                            incr->property,
+                            incr->target,
+                            8,
+                            PropModeReplace,
+                            NULL,
+                            0);
+            removeIncr(incr, GLFW_TRUE);
+            _glfwReleaseErrorHandlerX11();
+            continue;
+        }
+
+        memcpy(copy, incr->data + incr->offset, size);
+        incr->copy = copy;
+        incr->data = copy;
+        incr->size = size;
+        incr->offset = 0;
+    }
+}
+
+// Drops cached conversions of the selection data
+// Unfinished incremental transfers keep their own copy of the remaining data
+// and are completed normally
+//
+static void clearSelectionData(void)
+{
+    detachIncrs();
+
+    free(_glfw.x11.clipboardLatin1);
+    _glfw.x11.clipboardLatin1 = NULL;
+    _glfw.x11.clipboardLatin1Length = 0;
+    _glfw.x11.clipboardLength = 0;
+
+    free(_glfw.x11.clipboardTargets);
+    _glfw.x11.clipboardTargets = NULL;
+}
+
+// Makes the helper window the owner of the clipboard selection
+//
+static void acquireClipboard(void)
+{
+    XSetSelectionOwner(_glfw.x11.display,
+                       _glfw.x11.CLIPBOARD,
+                       _glfw.x11.helperWindowHandle,
+                       CurrentTime);
+
+    if (XGetSelectionOwner(_glfw.x11.display, _glfw.x11.CLIPBOARD) !=
+        _glfw.x11.helperWindowHandle)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Failed to become owner of clipboard selection");
+    }
+}
+
+// Writes selection data to the property of the requestor, starting an
+// incremental transfer if the data is too large for a single request
+//
+static GLFWbool writeSelectionData(Window requestor,
+                                   Atom property,
+                                   Atom target,
+                                   const char* data,
+                                   size_t size)
+{
+    _GLFWincrX11* incrs;
+    _GLFWincrX11* incr;
+    long lowerBound;
+
+    if (size <= getMaxPropertySize())
+    {
+        XChangeProperty(_glfw.x11.display,
+                        requestor,
+                        property,
+                        target,
+                        8,
+                        PropModeReplace,
+                        (unsigned char*) data,
+                        (int) size);
+
+        return GLFW_TRUE;
+    }
+
+    incr = findIncr(requestor, property);
+    if (!incr)
+    {
+        incrs = realloc(_glfw.x11.incrs,
+                        sizeof(_GLFWincrX11) * (_glfw.x11.incrCount + 1));
+        if (!incrs)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return GLFW_FALSE;
+        }
+
+        _glfw.x11.incrs = incrs;
+        incr = incrs + _glfw.x11.incrCount++;
+        incr->copy = NULL;
+    }
+
+    // A new request to the same property replaces the unfinished transfer
+    free(incr->copy);
+    incr->copy = NULL;
+
+    incr->requestor = requestor;
+    incr->property = property;
+    incr->target = target;
+    incr->data = data;
+    incr->size = size;
+    incr->offset = 0;
+    incr->deadline = getTransferTime() +
+        _glfw.hints.init.x11.clipboardTimeout / 1000.0;
+
+    // The requestor deleting the property is the signal to send the next part,
+    // so property changes must be selected before the transfer starts
+    if (!isOwnWindow(requestor))
+        XSelectInput(_glfw.x11.display, requestor, PropertyChangeMask);
+
+    // The INCR property holds a lower bound on the size of the data
+    lowerBound = (long) size;
+
+    XChangeProperty(_glfw.x11.display,
+                    requestor,
+                    property,
+                    _glfw.x11.INCR,
+                    32,
+                    PropModeReplace,
+                    (unsigned char*) &lowerBound,
+                    1);
+
+    return GLFW_TRUE;
+}
+
+// Sends the next part of an incremental selection transfer
+//
+static void handleIncrEvent(const XPropertyEvent* event)
+{
+    _GLFWincrX11* incr = findIncr(event->window, event->atom);
+    size_t size = incr->size - incr->offset;
+
+    if (size > getMaxPropertySize())
+        size = getMaxPropertySize();
+
+    // A zero-length part marks the end of the data
+    XChangeProperty(_glfw.x11.display,
+                    incr->requestor,
+                    incr->property,
+                    incr->target,
+                    8,
+                    PropModeReplace,
+                    (unsigned char*) incr->data + incr->offset,
+                    (int) size);
+
+    if (size == 0)
+        removeIncr(incr, GLFW_TRUE);
+    else
+    {
+        incr->offset += size;
+        incr->deadline = getTransferTime() +
+            _glfw.hints.init.x11.clipboardTimeout / 1000.0;
+    }
+
+    XFlush(_glfw.x11.display);
+}
+
+// Drops incremental selection transfers whose requestor has stopped responding
+//
+static void checkIncrTimeouts(void)
+{
+    int i;
+    const double time = getTransferTime();
+
+    for (i = _glfw.x11.incrCount - 1;  i >= 0;  i--)
+    {
+        if (time >= _glfw.x11.incrs[i].deadline)
+            removeIncr(_glfw.x11.incrs + i, GLFW_FALSE);
+    }
+}
+
+// Set the specified property to the selection converted to the requested target
+//
+static Atom writeTargetToProperty(const XSelectionRequestEvent* request)
+{
+    size_t size;
+    const char* data;
+
+    if (request->property == None)
+    {
+        // The requester is a legacy client (ICCCM section 2.2)
+        // We don't support legacy clients, so fail here
+        return None;
+    }
+
+    if (request->target == _glfw.x11.TARGETS)
+    {
+        // The list of supported targets was requested
+
+        int count = 2;
+        Atom* targets;
+
+        if (_glfw.x11.clipboardString)
+            targets = calloc(5, sizeof(Atom));
+        else
+            targets = calloc(2 + _glfw.clipboard.count, sizeof(Atom));
+
+        if (!targets)
+            return None;
+
+        targets[0] = _glfw.x11.TARGETS;
+        targets[1] = _glfw.x11.MULTIPLE;
+
+        if (_glfw.x11.clipboardString)
+        {
+            targets[count++] = _glfw.x11.UTF8_STRING;
+            targets[count++] = _glfw.x11.COMPOUND_STRING;
+            targets[count++] = XA_STRING;
+        }
+        else
+        {
+            int i;
+
+            for (i = 0;  i < _glfw.clipboard.count;  i++)
+                targets[count++] = _glfw.x11.clipboardTargets[i];
+        }
+
+        XChangeProperty(_glfw.x11.display,
+                        request->requestor,
+                        request->property,
+                        XA_ATOM,
+                        32,
+                        PropModeReplace,
+                        (unsigned char*) targets,
+                        count);
+
+        free(targets);
+        return request->property;
+    }
+
+    if (request->target == _glfw.x11.MULTIPLE)
+    {
+        // Multiple conversions were requested
+
+        Atom* targets;
+        unsigned long i, count;
+
+        count = _glfwGetWindowPropertyX11(request->requestor,
+                                          request->property,
+                                          _glfw.x11.ATOM_PAIR,
+                                          (unsigned char**) &targets);
+
+        for (i = 0;  i < count;  i += 2)
+        {
+            data = getSelectionData(targets[i], &size);
+
+            if (!data ||
+                !writeSelectionData(request->requestor,
+                                    targets[i + 1],
+                                    targets[i],
+                                    data,
+                                    size))
+            {
+                targets[i + 1] = None;
+            }
+        }
+
+        XChangeProperty(_glfw.x11.display,
+                        request->requestor,
+                        request->property,
+                        _glfw.x11.ATOM_PAIR,
+                        32,
+                        PropModeReplace,
+                        (unsigned char*) targets,
+                        count);
+
+        XFree(targets);
+
+        return request->property;
+    }
+
+    if (request->target == _glfw.x11.SAVE_TARGETS)
+    {
+        // The request is a check whether we support SAVE_TARGETS
+        // It should be handled as a no-op side effect target
+
+        XChangeProperty(_glfw.x11.display,
+                        request->requestor,
+                        request->property,
+                        _glfw.x11.NULL_,
+                        32,
+                        PropModeReplace,
+                        NULL,
+                        0);
+
+        return request->property;
+    }
+
+    // Conversion to a data target was requested
+
+    data = getSelectionData(request->target, &size);
+    if (!data)
+    {
+        // The requested target is not supported
+        return None;
+    }
+
+    if (!writeSelectionData(request->requestor,
+                            request->property,
+                            request->target,
+                            data,
+                            size))
+    {
+        return None;
+    }
+
+    return request->property;
+}
+
+static void handleSelectionClear(XEvent* event)
+{
+    clearSelectionData();
+    free(_glfw.x11.clipboardString);
+    _glfw.x11.clipboardString = NULL;
+    _glfwFreeClipboardOffer();
+}
+
+static void handleSelectionRequest(XEvent* event)
+{
+    const XSelectionRequestEvent* request = &event->xselectionrequest;
+
+    XEvent reply;
+    memset(&reply, 0, sizeof(reply));
 
     reply.xselection.property = writeTargetToProperty(request);
     reply.xselection.type = SelectionNotify;
@@ -811,6 +1513,431 @@ static void handleSelectionRequest(XEvent* event)
     XSendEvent(_glfw.x11.display, request->requestor, False, 0, &reply);
 }
 
+// Returns whether the event belongs to the clipboard transfer
+//
+static Bool isTransferEvent(Display* display, XEvent* event, XPointer pointer)
+{
+    if (event->xany.window != _glfw.x11.helperWindowHandle)
+        return False;
+
+    if (event->type == SelectionNotify)
+        return event->xselection.selection == _glfw.x11.CLIPBOARD;
+
+    if (event->type == PropertyNotify)
+    {
+        return event->xproperty.atom == _glfw.x11.GLFW_SELECTION &&
+               event->xproperty.state == PropertyNewValue;
+    }
+
+    return False;
+}
+
+// Asks the clipboard owner to convert the selection to the specified target
+//
+static void convertSelection(Atom target, int state)
+{
+    XConvertSelection(_glfw.x11.display,
+                      _glfw.x11.CLIPBOARD,
+                      target,
+                      _glfw.x11.GLFW_SELECTION,
+                      _glfw.x11.helperWindowHandle,
+                      CurrentTime);
+    XFlush(_glfw.x11.display);
+
+    _glfw.x11.transfer.state = state;
+    _glfw.x11.transfer.target = target;
+    _glfw.x11.transfer.deadline = getTransferTime() +
+        _glfw.hints.init.x11.clipboardTimeout / 1000.0;
+}
+
+// Starts a clipboard transfer for the specified request
+//
+static void startTransfer(int request, Atom target)
+{
+    _glfw.x11.transfer.request = request;
+
+    if (target == _glfw.x11.TARGETS)
+        convertSelection(target, _GLFW_TRANSFER_TARGETS);
+    else
+        convertSelection(target, _GLFW_TRANSFER_DATA);
+}
+
+// Reads and deletes the selection property of the helper window
+//
+static unsigned long readTransferProperty(Atom* type, unsigned char** value)
+{
+    int format;
+    unsigned long itemCount, bytesAfter;
+
+    XGetWindowProperty(_glfw.x11.display,
+                       _glfw.x11.helperWindowHandle,
+                       _glfw.x11.GLFW_SELECTION,
+                       0,
+                       LONG_MAX,
+                       True,
+                       AnyPropertyType,
+                       type,
+                       &format,
+                       &itemCount,
+                       &bytesAfter,
+                       value);
+
+    return itemCount;
+}
+
+// Makes room for the specified number of bytes in the transfer buffer
+//
+static GLFWbool reserveTransferData(size_t size)
+{
+    char* data;
+    size_t capacity = _glfw.x11.transfer.capacity;
+    const size_t needed = _glfw.x11.transfer.size + size;
+
+    if (needed < _glfw.x11.transfer.size)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
+
+    if (needed < capacity)
+        return GLFW_TRUE;
+
+    if (capacity < 4096)
+        capacity = 4096;
+    while (capacity <= needed)
+    {
+        if (capacity > SIZE_MAX / 2)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return GLFW_FALSE;
+        }
+
+        capacity *= 2;
+    }
+
+    data = realloc(_glfw.x11.transfer.data, capacity);
+    if (!data)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
+
+    _glfw.x11.transfer.data = data;
+    _glfw.x11.transfer.capacity = capacity;
+    return GLFW_TRUE;
+}
+
+// Appends received data to the transfer buffer
+//
+static GLFWbool appendTransferData(const unsigned char* data, size_t size)
+{
+    if (!reserveTransferData(size))
+        return GLFW_FALSE;
+
+    memcpy(_glfw.x11.transfer.data + _glfw.x11.transfer.size, data, size);
+    _glfw.x11.transfer.size += size;
+    _glfw.x11.transfer.data[_glfw.x11.transfer.size] = '\0';
+    return GLFW_TRUE;
+}
+
+// Reports that the clipboard could not be converted for the current request
+//
+static void reportTransferFailure(void)
+{
+    if (_glfw.x11.transfer.request == _GLFW_REQUEST_TYPES)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Failed to retrieve clipboard types");
+    }
+    else if (_glfw.x11.transfer.request == _GLFW_REQUEST_DATA)
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "X11: Failed to convert clipboard to requested type");
+    }
+    else
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "X11: Failed to convert clipboard to string");
+    }
+}
+
+// Stores the names of the listed targets as the clipboard types
+//
+static void setClipboardTypes(const Atom* targets, unsigned long count)
+{
+    unsigned long i;
+    char** names = calloc(count, sizeof(char*));
+
+    if (!names ||
+        !XGetAtomNames(_glfw.x11.display, (Atom*) targets, (int) count, names))
+    {
+        free(names);
+        return;
+    }
+
+    _glfw.x11.clipboardTypes = calloc(count, sizeof(char*));
+
+    for (i = 0;  i < count;  i++)
+    {
+        // Side effect and meta targets are not data types
+        if (_glfw.x11.clipboardTypes &&
+            targets[i] != _glfw.x11.TARGETS &&
+            targets[i] != _glfw.x11.MULTIPLE &&
+            targets[i] != _glfw.x11.SAVE_TARGETS &&
+            strcmp(names[i], "TIMESTAMP") != 0)
+        {
+            _glfw.x11.clipboardTypes[_glfw.x11.clipboardTypeCount++] =
+                strdup(names[i]);
+        }
+
+        XFree(names[i]);
+    }
+
+    free(names);
+}
+
+// Ends the clipboard transfer and passes its result to pending requests
+//
+static void finishTransfer(GLFWbool success)
+{
+    char* string = NULL;
+    const char* previous = _glfw.x11.clipboardString;
+    const int request = _glfw.x11.transfer.request;
+    const size_t size = _glfw.x11.transfer.size;
+
+    if (success && reserveTransferData(0))
+    {
+        string = _glfw.x11.transfer.data;
+        string[_glfw.x11.transfer.size] = '\0';
+    }
+    else
+        free(_glfw.x11.transfer.data);
+
+    _glfw.x11.transfer.request = _GLFW_REQUEST_STRING;
+    _glfw.x11.transfer.state = _GLFW_TRANSFER_NONE;
+    _glfw.x11.transfer.target = None;
+    _glfw.x11.transfer.data = NULL;
+    _glfw.x11.transfer.size = 0;
+    _glfw.x11.transfer.capacity = 0;
+
+    XDeleteProperty(_glfw.x11.display,
+                    _glfw.x11.helperWindowHandle,
+                    _glfw.x11.GLFW_SELECTION);
+
+    if (request == _GLFW_REQUEST_DATA)
+    {
+        _glfw.x11.clipboardData = string;
+        _glfw.x11.clipboardDataSize = string ? size : 0;
+        return;
+    }
+    else if (request == _GLFW_REQUEST_TYPES)
+    {
+        free(string);
+        return;
+    }
+
+    _glfwInputClipboardString(string);
+
+    // A blocking request keeps the string for glfwGetClipboardString, unless
+    // one of the callbacks has replaced the clipboard contents
+    if (_glfw.x11.transfer.blocking && _glfw.x11.clipboardString == previous)
+    {
+        free(_glfw.x11.clipboardString);
+        _glfw.x11.clipboardString = string;
+    }
+    else
+        free(string);
+}
+
+// Advances the clipboard transfer with a selection or property event
+//
+static void handleTransferEvent(const XEvent* event)
+{
+    const Atom formats[] = { _glfw.x11.UTF8_STRING,
+                             _glfw.x11.COMPOUND_STRING,
+                             XA_STRING };
+    const int formatCount = sizeof(formats) / sizeof(formats[0]);
+
+    if (event->type == SelectionNotify)
+    {
+        if (_glfw.x11.transfer.state == _GLFW_TRANSFER_NONE ||
+            _glfw.x11.transfer.state == _GLFW_TRANSFER_INCR ||
+            event->xselection.target != _glfw.x11.transfer.target)
+        {
+            // This is a late reply to a transfer that has timed out
+            return;
+        }
+
+        if (event->xselection.property == None)
+        {
+            if (_glfw.x11.transfer.state == _GLFW_TRANSFER_TARGETS &&
+                _glfw.x11.transfer.request == _GLFW_REQUEST_STRING)
+            {
+                // The owner does not list its targets, so ask for the
+                // preferred format directly
+                convertSelection(_glfw.x11.UTF8_STRING, _GLFW_TRANSFER_DATA);
+                return;
+            }
+
+            reportTransferFailure();
+            finishTransfer(GLFW_FALSE);
+            return;
+        }
+
+        if (_glfw.x11.transfer.state == _GLFW_TRANSFER_TARGETS &&
+            _glfw.x11.transfer.request == _GLFW_REQUEST_TYPES)
+        {
+            Atom type;
+            Atom* targets = NULL;
+            const unsigned long count =
+                readTransferProperty(&type, (unsigned char**) &targets);
+
+            if (type == XA_ATOM && count)
+                setClipboardTypes(targets, count);
+
+            if (targets)
+                XFree(targets);
+
+            finishTransfer(GLFW_TRUE);
+        }
+        else if (_glfw.x11.transfer.state == _GLFW_TRANSFER_TARGETS)
+        {
+            int i;
+            Atom type, target = None;
+            Atom* targets = NULL;
+            const unsigned long count =
+                readTransferProperty(&type, (unsigned char**) &targets);
+
+            if (type == XA_ATOM)
+            {
+                for (i = 0;  i < formatCount && target == None;  i++)
+                {
+                    unsigned long j;
+
+                    for (j = 0;  j < count;  j++)
+                    {
+                        if (targets[j] == formats[i])
+                        {
+                            target = formats[i];
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if (targets)
+                XFree(targets);
+
+            if (target == None)
+            {
+                reportTransferFailure();
+                finishTransfer(GLFW_FALSE);
+                return;
+            }
+
+            convertSelection(target, _GLFW_TRANSFER_DATA);
+        }
+        else
+        {
+            Atom type;
+            unsigned char* data = NULL;
+            const unsigned long size = readTransferProperty(&type, &data);
+
+            if (type == _glfw.x11.INCR)
+            {
+                // The data will arrive in chunks, each written to the property
+                // after the previous one has been deleted (ICCCM section 2.7.2)
+                // The INCR property is a lower bound on the total size, but it
+                // comes from another client, so only a bounded amount of it is
+                // reserved and the buffer grows from the actual chunks
+
+                if (size)
+                {
+                    unsigned long hint = *((unsigned long*) data);
+                    if (hint > _GLFW_INCR_HINT_LIMIT)
+                        hint = _GLFW_INCR_HINT_LIMIT;
+
+                    reserveTransferData(hint);
+                }
+
+                _glfw.x11.transfer.state = _GLFW_TRANSFER_INCR;
+                _glfw.x11.transfer.deadline = getTransferTime() +
+                    _glfw.hints.init.x11.clipboardTimeout / 1000.0;
+                XFlush(_glfw.x11.display);
+            }
+            else
+                finishTransfer(appendTransferData(data, size));
+
+            if (data)
+                XFree(data);
+        }
+    }
+    else if (event->type == PropertyNotify)
+    {
+        Atom type;
+        unsigned char* data = NULL;
+        unsigned long size;
+
+        if (_glfw.x11.transfer.state != _GLFW_TRANSFER_INCR)
+            return;
+
+        size = readTransferProperty(&type, &data);
+        if (size == 0)
+        {
+            // A zero-length chunk marks the end of the data
+            finishTransfer(GLFW_TRUE);
+        }
+        else if (!appendTransferData(data, size))
+            finishTransfer(GLFW_FALSE);
+        else
+        {
+            _glfw.x11.transfer.deadline = getTransferTime() +
+                _glfw.hints.init.x11.clipboardTimeout / 1000.0;
+            XFlush(_glfw.x11.display);
+        }
+
+        if (data)
+            XFree(data);
+    }
+}
+
+// Ends the clipboard transfer if the owner has stopped responding
+//
+static void checkTransferTimeout(void)
+{
+    if (_glfw.x11.transfer.state == _GLFW_TRANSFER_NONE)
+        return;
+
+    if (getTransferTime() >= _glfw.x11.transfer.deadline)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Clipboard owner did not respond in time");
+        finishTransfer(GLFW_FALSE);
+    }
+}
+
+// Processes clipboard transfer events until the transfer has ended, while
+// leaving all other events in the queue
+//
+static void waitForTransfer(void)
+{
+    while (_glfw.x11.transfer.state != _GLFW_TRANSFER_NONE)
+    {
+        XEvent event;
+        double timeout;
+
+        if (XCheckIfEvent(_glfw.x11.display, &event, isTransferEvent, NULL))
+        {
+            handleTransferEvent(&event);
+            continue;
+        }
+
+        timeout = _glfw.x11.transfer.deadline - getTransferTime();
+        if (timeout <= 0.0 || !waitForEvent(&timeout))
+            checkTransferTimeout();
+    }
+}
+
 // Make the specified window and its video mode active on its monitor
 //
 static GLFWbool acquireMonitor(_GLFWwindow* window)
@@ -847,6 +1974,9 @@ static GLFWbool acquireMonitor(_GLFWwindow* window)
 
         XMoveResizeWindow(_glfw.x11.display, window->x11.handle,
                           xpos, ypos, mode.width, mode.height);
+
+        window->x11.posCached = GLFW_FALSE;
+        window->x11.sizeCached = GLFW_FALSE;
     }
 
     _glfwInputMonitorWindow(window->monitor, window);
@@ -876,62 +2006,6 @@ static void releaseMonitor(_GLFWwindow* window)
     }
 }
 
-// Encode a Unicode code point to a UTF-8 stream
-// Based on cutef8 by Jeff Bezanson (Public Domain)
-//
-static size_t encodeUTF8(char* s, unsigned int ch)
-{
-    size_t count = 0;
-
-    if (ch < 0x80)
-        s[count++] = (char) ch;
-    else if (ch < 0x800)
-    {
-        s[count++] = (ch >> 6) | 0xc0;
-        s[count++] = (ch & 0x3f) | 0x80;
-    }
-    else if (ch < 0x10000)
-    {
-        s[count++] = (ch >> 12) | 0xe0;
-        s[count++] = ((ch >> 6) & 0x3f) | 0x80;
-        s[count++] = (ch & 0x3f) | 0x80;
-    }
-    else if (ch < 0x110000)
-    {
-        s[count++] = (ch >> 18) | 0xf0;
-        s[count++] = ((ch >> 12) & 0x3f) | 0x80;
-        s[count++] = ((ch >> 6) & 0x3f) | 0x80;
-        s[count++] = (ch & 0x3f) | 0x80;
-    }
-
-    return count;
-}
-
-// Decode a Unicode code point from a UTF-8 stream
-// Based on cutef8 by Jeff Bezanson (Public Domain)
-//
-#if defined(X_HAVE_UTF8_STRING)
-static unsigned int decodeUTF8(const char** s)
-{
-    unsigned int ch = 0, count = 0;
-    static const unsigned int offsets[] =
-    {
-        0x00000000u, 0x00003080u, 0x000e2080u,
-        0x03c82080u, 0xfa082080u, 0x82082080u
-    };
-
-    do
-    {
-        ch = (ch << 6) + (unsigned char) **s;
-        (*s)++;
-        count++;
-    } while ((**s & 0xc0) == 0x80);
-
-    assert(count <= 6);
-    return ch - offsets[count - 1];
-}
-#endif /*X_HAVE_UTF8_STRING*/
-
 // Process the specified X event
 //
 static void processEvent(XEvent *event)
@@ -951,8 +2025,18 @@ static void processEvent(XEvent *event)
     {
         if (event->type == _glfw.x11.randr.eventBase + RRNotify)
         {
+            const XRRNotifyEvent* notify = (XRRNotifyEvent*) event;
+
             XRRUpdateConfiguration(event);
-            _glfwPollMonitorsX11();
+
+            // Any CRTC or output change may move a monitor or change its mode
+            _glfwInvalidateMonitorsX11();
+
+            // Output changes are coalesced and applied once all pending events
+            // have been processed
+            if (notify->subtype == RRNotify_OutputChange)
+                _glfwInputOutputChangeX11((XRROutputChangeNotifyEvent*) event);
+
             return;
         }
     }
@@ -963,28 +2047,35 @@ static void processEvent(XEvent *event)
         {
             _GLFWwindow* window = _glfw.x11.disabledCursorWindow;
 
-            if (window &&
-                event->xcookie.extension == _glfw.x11.xi.majorOpcode &&
+            if (event->xcookie.extension == _glfw.x11.xi.majorOpcode &&
                 XGetEventData(_glfw.x11.display, &event->xcookie) &&
                 event->xcookie.evtype == XI_RawMotion)
             {
                 XIRawEvent* re = event->xcookie.data;
                 if (re->valuators.mask_len)
                 {
+                    // NOTE: raw_values holds the unaccelerated values, with
+                    //       their full sub-pixel precision
                     const double* values = re->raw_values;
-                    double xpos = window->virtualCursorPosX;
-                    double ypos = window->virtualCursorPosY;
+                    double dx = 0.0, dy = 0.0;
 
                     if (XIMaskIsSet(re->valuators.mask, 0))
                     {
-                        xpos += *values;
+                        dx = *values;
                         values++;
                     }
 
                     if (XIMaskIsSet(re->valuators.mask, 1))
-                        ypos += *values;
+                        dy = *values;
+
+                    if (window)
+                    {
+                        _glfwInputCursorPos(window,
+                                            window->virtualCursorPosX + dx,
+                                            window->virtualCursorPosY + dy);
+                    }
 
-                    _glfwInputCursorPos(window, xpos, ypos);
+                    queueRawMotion(dx, dy, re->time);
                 }
             }
 
@@ -1004,6 +2095,16 @@ static void processEvent(XEvent *event)
         handleSelectionRequest(event);
         return;
     }
+    else if (isTransferEvent(_glfw.x11.display, event, NULL))
+    {
+        handleTransferEvent(event);
+        return;
+    }
+    else if (isIncrEvent(_glfw.x11.display, event, NULL))
+    {
+        handleIncrEvent(&event->xproperty);
+        return;
+    }
 
     window = findWindowByHandle(event->xany.window);
     if (window == NULL)
@@ -1049,19 +2150,32 @@ static void processEvent(XEvent *event)
 
                     if (status == XBufferOverflow)
                     {
-                        chars = calloc(count + 1, 1);
-                        count = Xutf8LookupString(window->x11.ic,
-                                                  &event->xkey,
-                                                  chars, count,
-                                                  NULL, &status);
+                        if ((size_t) count >= window->x11.textSize)
+                        {
+                            char* text = realloc(window->x11.text, count + 1);
+                            if (text)
+                            {
+                                window->x11.text = text;
+                                window->x11.textSize = count + 1;
+                            }
+                        }
+
+                        if ((size_t) count < window->x11.textSize)
+                        {
+                            chars = window->x11.text;
+                            count = Xutf8LookupString(window->x11.ic,
+                                                      &event->xkey,
+                                                      chars, count,
+                                                      NULL, &status);
+                        }
+                        else
+                            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
                     }
 
                     if (status == XLookupChars || status == XLookupBoth)
                     {
-                        const char* c = chars;
                         chars[count] = '\0';
-                        while (c - chars < count)
-                            _glfwInputChar(window, decodeUTF8(&c), mods, plain);
+                        _glfwInputText(window, chars, mods, plain);
                     }
 #else /*X_HAVE_UTF8_STRING*/
                     wchar_t buffer[16];
@@ -1087,10 +2201,10 @@ static void processEvent(XEvent *event)
                         for (i = 0;  i < count;  i++)
                             _glfwInputChar(window, chars[i], mods, plain);
                     }
-#endif /*X_HAVE_UTF8_STRING*/
 
                     if (chars != buffer)
                         free(chars);
+#endif /*X_HAVE_UTF8_STRING*/
                 }
             }
             else
@@ -1228,12 +2342,19 @@ static void processEvent(XEvent *event)
             if (window->cursorMode == GLFW_CURSOR_HIDDEN)
                 _glfwPlatformSetCursorMode(window, GLFW_CURSOR_HIDDEN);
 
+            window->x11.lastCursorPosX = event->xcrossing.x;
+            window->x11.lastCursorPosY = event->xcrossing.y;
+            window->x11.cursorTracked = GLFW_TRUE;
+            window->x11.cursorInside = GLFW_TRUE;
+
             _glfwInputCursorEnter(window, GLFW_TRUE);
             return;
         }
 
         case LeaveNotify:
         {
+            window->x11.cursorTracked = GLFW_FALSE;
+            window->x11.cursorInside = GLFW_FALSE;
             _glfwInputCursorEnter(window, GLFW_FALSE);
             return;
         }
@@ -1249,6 +2370,9 @@ static void processEvent(XEvent *event)
 
                 if (window->cursorMode == GLFW_CURSOR_DISABLED)
                 {
+                    // The last cursor position is not updated below
+                    window->x11.cursorTracked = GLFW_FALSE;
+
                     if (_glfw.x11.disabledCursorWindow != window)
                         return;
                     if (_glfw.x11.xi.available)
@@ -1267,11 +2391,16 @@ static void processEvent(XEvent *event)
 
             window->x11.lastCursorPosX = x;
             window->x11.lastCursorPosY = y;
+            window->x11.cursorTracked = GLFW_TRUE;
             return;
         }
 
         case ConfigureNotify:
         {
+            // The window may have moved under the cursor without any motion
+            // event, so the tracked cursor position is no longer reliable
+            window->x11.cursorTracked = GLFW_FALSE;
+
             if (event->xconfigure.width != window->x11.width ||
                 event->xconfigure.height != window->x11.height)
             {
@@ -1287,10 +2416,12 @@ static void processEvent(XEvent *event)
                 window->x11.height = event->xconfigure.height;
             }
 
-            if (event->xconfigure.x != window->x11.xpos ||
-                event->xconfigure.y != window->x11.ypos)
+            window->x11.sizeCached = GLFW_TRUE;
+
+            if (window->x11.overrideRedirect || event->xany.send_event)
             {
-                if (window->x11.overrideRedirect || event->xany.send_event)
+                if (event->xconfigure.x != window->x11.xpos ||
+                    event->xconfigure.y != window->x11.ypos)
                 {
                     _glfwInputWindowPos(window,
                                         event->xconfigure.x,
@@ -1299,8 +2430,24 @@ static void processEvent(XEvent *event)
                     window->x11.xpos = event->xconfigure.x;
                     window->x11.ypos = event->xconfigure.y;
                 }
+
+                window->x11.posCached = GLFW_TRUE;
             }
+            else
+            {
+                // The position in a real event is relative to the parent,
+                // which is the frame window if the WM has reparented us
+                window->x11.posCached = GLFW_FALSE;
+            }
+
+            return;
+        }
 
+        case ReparentNotify:
+        {
+            // The position of the window relative to the root has likely
+            // changed without a synthetic ConfigureNotify
+            window->x11.posCached = GLFW_FALSE;
             return;
         }
 
@@ -1530,6 +2677,7 @@ static void processEvent(XEvent *event)
             if (window->x11.ic)
                 XSetICFocus(window->x11.ic);
 
+            _glfw.x11.focusedWindow = window;
             _glfwInputWindowFocus(window, GLFW_TRUE);
             return;
         }
@@ -1553,6 +2701,9 @@ static void processEvent(XEvent *event)
             if (window->monitor && window->autoIconify)
                 _glfwPlatformIconifyWindow(window);
 
+            if (_glfw.x11.focusedWindow == window)
+                _glfw.x11.focusedWindow = NULL;
+
             _glfwInputWindowFocus(window, GLFW_FALSE);
             return;
         }
@@ -1620,23 +2771,116 @@ unsigned long _glfwGetWindowPropertyX11(Window window,
                                         Atom type,
                                         unsigned char** value)
 {
-    Atom actualType;
-    int actualFormat;
-    unsigned long itemCount, bytesAfter;
+    _GLFWpropertyrequestX11 request;
+    _glfwRequestWindowPropertyX11(&request, window, property, type);
+    return _glfwReadWindowPropertyX11(&request, value);
+}
 
-    XGetWindowProperty(_glfw.x11.display,
-                       window,
-                       property,
-                       0,
-                       LONG_MAX,
-                       False,
-                       type,
-                       &actualType,
-                       &actualFormat,
-                       &itemCount,
-                       &bytesAfter,
-                       value);
+// Sends a request for a single window property of the specified type
+// The reply is not waited for until _glfwReadWindowPropertyX11 is called,
+// allowing several independent requests to share a single round trip
+//
+void _glfwRequestWindowPropertyX11(_GLFWpropertyrequestX11* request,
+                                   Window window,
+                                   Atom property,
+                                   Atom type)
+{
+    request->window = window;
+    request->property = property;
+    request->type = type;
+
+    if (_glfw.x11.xcb.connection)
+    {
+        request->cookie = xcb_get_property(_glfw.x11.xcb.connection,
+                                           0,
+                                           (uint32_t) window,
+                                           (uint32_t) property,
+                                           (uint32_t) type,
+                                           0,
+                                           UINT32_MAX / 4);
+    }
+}
+
+// Waits for the reply to a window property request
+// The value is returned in the Xlib layout and should be freed with XFree
+//
+unsigned long _glfwReadWindowPropertyX11(_GLFWpropertyrequestX11* request,
+                                         unsigned char** value)
+{
+    unsigned long i, itemCount;
+    const void* source;
+    xcb_get_property_reply_t* reply;
+    xcb_generic_error_t* error = NULL;
+
+    if (!_glfw.x11.xcb.connection)
+    {
+        Atom actualType;
+        int actualFormat;
+        unsigned long bytesAfter;
+
+        XGetWindowProperty(_glfw.x11.display,
+                           request->window,
+                           request->property,
+                           0,
+                           LONG_MAX,
+                           False,
+                           request->type,
+                           &actualType,
+                           &actualFormat,
+                           &itemCount,
+                           &bytesAfter,
+                           value);
+
+        return itemCount;
+    }
+
+    *value = NULL;
+
+    reply = xcb_get_property_reply(_glfw.x11.xcb.connection,
+                                   request->cookie,
+                                   &error);
+    if (!reply)
+    {
+        free(error);
+        return 0;
+    }
+
+    itemCount = reply->value_len;
+    source = xcb_get_property_value(reply);
+
+    if (!itemCount)
+    {
+        free(reply);
+        return 0;
+    }
+
+    // NOTE: Xlib returns 16-bit and 32-bit items as short and long and
+    //       terminates 8-bit data, so callers expect that layout
+    if (reply->format == 8)
+    {
+        *value = calloc(itemCount + 1, 1);
+        memcpy(*value, source, itemCount);
+    }
+    else if (reply->format == 16)
+    {
+        short* target = calloc(itemCount, sizeof(short));
+        for (i = 0;  i < itemCount;  i++)
+            target[i] = ((const int16_t*) source)[i];
+
+        *value = (unsigned char*) target;
+    }
+    else if (reply->format == 32)
+    {
+        long* target = calloc(itemCount, sizeof(long));
+        for (i = 0;  i < itemCount;  i++)
+            target[i] = ((const uint32_t*) source)[i];
 
+        *value = (unsigned char*) target;
+    }
+    else
+        itemCount = 0;
+
+    free(reply);
     return itemCount;
 }
 
@@ -1683,6 +2927,10 @@ void _glfwPushSelectionToManagerX11(void)
             }
         }
 
+        // Large selections are sent to the manager in parts
+        while (XCheckIfEvent(_glfw.x11.display, &event, isIncrEvent, NULL))
+            handleIncrEvent(&event.xproperty);
+
         waitForEvent(NULL);
     }
 }
@@ -1771,6 +3019,20 @@ void _glfwPlatformDestroyWindow(_GLFWwindow* window)
 {
     if (_glfw.x11.disabledCursorWindow == window)
         _glfw.x11.disabledCursorWindow = NULL;
+    if (_glfw.x11.focusedWindow == window)
+        _glfw.x11.focusedWindow = NULL;
+
+    if (_glfw.x11.xi.rawWindow == window)
+    {
+        _glfw.x11.xi.rawWindow = NULL;
+        _glfw.x11.xi.rawSampleCount = 0;
+    }
+
+    if (window->rawMouseMotion)
+    {
+        window->rawMouseMotion = GLFW_FALSE;
+        updateRawMotionSelection();
+    }
 
     if (window->monitor)
         releaseMonitor(window);
@@ -1781,6 +3043,10 @@ void _glfwPlatformDestroyWindow(_GLFWwindow* window)
         window->x11.ic = NULL;
     }
 
+    free(window->x11.text);
+    window->x11.text = NULL;
+    window->x11.textSize = 0;
+
     if (window->context.destroy)
         window->context.destroy(window);
 
@@ -1837,7 +3103,7 @@ void _glfwPlatformSetWindowIcon(_GLFWwindow* window,
 {
     if (count)
     {
-        int i, j, longCount = 0;
+        int i, longCount = 0;
 
         for (i = 0;  i < count;  i++)
             longCount += 2 + images[i].width * images[i].height;
@@ -1850,13 +3116,9 @@ void _glfwPlatformSetWindowIcon(_GLFWwindow* window,
             *target++ = images[i].width;
             *target++ = images[i].height;
 
-            for (j = 0;  j < images[i].width * images[i].height;  j++)
-            {
-                *target++ = (images[i].pixels[j * 4 + 0] << 16) |
-                            (images[i].pixels[j * 4 + 1] <<  8) |
-                            (images[i].pixels[j * 4 + 2] <<  0) |
-                            (images[i].pixels[j * 4 + 3] << 24);
-            }
+            _glfwConvertToARGBLong(target, images[i].pixels,
+                                   images[i].width * images[i].height);
+            target += images[i].width * images[i].height;
         }
 
         XChangeProperty(_glfw.x11.display, window->x11.handle,
@@ -1880,10 +3142,38 @@ void _glfwPlatformSetWindowIcon(_GLFWwindow* window,
 void _glfwPlatformGetWindowPos(_GLFWwindow* window, int* xpos, int* ypos)
 {
     Window dummy;
-    int x, y;
+    int x = 0, y = 0;
+
+    if (window->x11.posCached)
+    {
+        x = window->x11.xpos;
+        y = window->x11.ypos;
+    }
+    else if (_glfw.x11.xcb.connection)
+    {
+        xcb_generic_error_t* error = NULL;
+        const xcb_translate_coordinates_cookie_t cookie =
+            xcb_translate_coordinates(_glfw.x11.xcb.connection,
+                                      (uint32_t) window->x11.handle,
+                                      (uint32_t) _glfw.x11.root,
+                                      0, 0);
+        xcb_translate_coordinates_reply_t* reply =
+            xcb_translate_coordinates_reply(_glfw.x11.xcb.connection,
+                                            cookie, &error);
+        if (reply)
+        {
+            x = reply->dst_x;
+            y = reply->dst_y;
+            free(reply);
+        }
 
-    XTranslateCoordinates(_glfw.x11.display, window->x11.handle, _glfw.x11.root,
-                          0, 0, &x, &y, &dummy);
+        free(error);
+    }
+    else
+    {
+        XTranslateCoordinates(_glfw.x11.display, window->x11.handle, _glfw.x11.root,
+                              0, 0, &x, &y, &dummy);
+    }
 
     if (xpos)
         *xpos = x;
@@ -1913,12 +3203,42 @@ void _glfwPlatformSetWindowPos(_GLFWwindow* window, int xpos, int ypos)
 
     XMoveWindow(_glfw.x11.display, window->x11.handle, xpos, ypos);
     XFlush(_glfw.x11.display);
+
+    window->x11.posCached = GLFW_FALSE;
 }
 
 void _glfwPlatformGetWindowSize(_GLFWwindow* window, int* width, int* height)
 {
     XWindowAttributes attribs;
-    XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &attribs);
+
+    if (window->x11.sizeCached)
+    {
+        attribs.width = window->x11.width;
+        attribs.height = window->x11.height;
+    }
+    // NOTE: XGetWindowAttributes needs two round trips where a single
+    //       GetGeometry request is enough for the size
+    else if (_glfw.x11.xcb.connection)
+    {
+        xcb_generic_error_t* error = NULL;
+        const xcb_get_geometry_cookie_t cookie =
+            xcb_get_geometry(_glfw.x11.xcb.connection,
+                             (uint32_t) window->x11.handle);
+        xcb_get_geometry_reply_t* reply =
+            xcb_get_geometry_reply(_glfw.x11.xcb.connection, cookie, &error);
+
+        attribs.width = attribs.height = 0;
+        if (reply)
+        {
+            attribs.width = reply->width;
+            attribs.height = reply->height;
+            free(reply);
+        }
+
+        free(error);
+    }
+    else
+        XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &attribs);
 
     if (width)
         *width = attribs.width;
@@ -1942,6 +3262,8 @@ void _glfwPlatformSetWindowSize(_GLFWwindow* window, int width, int height)
     }
 
     XFlush(_glfw.x11.display);
+
+    window->x11.sizeCached = GLFW_FALSE;
 }
 
 void _glfwPlatformSetWindowSizeLimits(_GLFWwindow* window,
@@ -2098,6 +3420,9 @@ void _glfwPlatformShowWindow(_GLFWwindow* window)
     if (_glfwPlatformWindowVisible(window))
         return;
 
+    // The WM may place the window when it is mapped
+    window->x11.posCached = GLFW_FALSE;
+
     XMapWindow(_glfw.x11.display, window->x11.handle);
     waitForVisibilityNotify(window);
 }
@@ -2137,6 +3462,9 @@ void _glfwPlatformSetWindowMonitor(_GLFWwindow* window,
                                    int width, int height,
                                    int refreshRate)
 {
+    window->x11.posCached = GLFW_FALSE;
+    window->x11.sizeCached = GLFW_FALSE;
+
     if (window->monitor == monitor)
     {
         if (monitor)
@@ -2192,7 +3520,29 @@ int _glfwPlatformWindowIconified(_GLFWwindow* window)
 int _glfwPlatformWindowVisible(_GLFWwindow* window)
 {
     XWindowAttributes wa;
-    XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &wa);
+
+    if (_glfw.x11.xcb.connection)
+    {
+        xcb_generic_error_t* error = NULL;
+        const xcb_get_window_attributes_cookie_t cookie =
+            xcb_get_window_attributes(_glfw.x11.xcb.connection,
+                                      (uint32_t) window->x11.handle);
+        xcb_get_window_attributes_reply_t* reply =
+            xcb_get_window_attributes_reply(_glfw.x11.xcb.connection,
+                                            cookie, &error);
+
+        wa.map_state = IsUnmapped;
+        if (reply)
+        {
+            wa.map_state = reply->map_state;
+            free(reply);
+        }
+
+        free(error);
+    }
+    else
+        XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &wa);
+
     return wa.map_state == IsViewable;
 }
 
@@ -2341,8 +3691,19 @@ void _glfwPlatformPollEvents(void)
         processEvent(&event);
     }
 
+    if (_glfw.x11.randr.outputChangeCount)
+        _glfwUpdateMonitorsX11();
+
+    flushRawMotion();
+
+    checkTransferTimeout();
+    checkIncrTimeouts();
+
+    // NOTE: With XInput 2 the motion of the disabled cursor comes from raw
+    //       events, which are unaffected by the pointer being confined to the
+    //       window by the grab, so the cursor never needs to be re-centered
     window = _glfw.x11.disabledCursorWindow;
-    if (window)
+    if (window && !_glfw.x11.xi.available)
     {
         int width, height;
         _glfwPlatformGetWindowSize(window, &width, &height);
@@ -2362,16 +3723,35 @@ void _glfwPlatformPollEvents(void)
 void _glfwPlatformWaitEvents(void)
 {
     while (!XPending(_glfw.x11.display))
-        waitForEvent(NULL);
+    {
+        if (_glfw.x11.transfer.state != _GLFW_TRANSFER_NONE)
+        {
+            // Wake up in time to end a clipboard transfer that has stalled
+            double timeout = _glfw.x11.transfer.deadline - getTransferTime();
+            if (timeout <= 0.0 || !waitForEvent(&timeout))
+                break;
+        }
+        else
+            waitForEvent(NULL);
+    }
 
     _glfwPlatformPollEvents();
 }
 
 void _glfwPlatformWaitEventsTimeout(double timeout)
 {
+    if (_glfw.x11.transfer.state != _GLFW_TRANSFER_NONE)
+    {
+        // Wake up in time to end a clipboard transfer that has stalled
+        const double remaining =
+            _glfw.x11.transfer.deadline - getTransferTime();
+        if (timeout > remaining)
+            timeout = remaining;
+    }
+
     while (!XPending(_glfw.x11.display))
     {
-        if (!waitForEvent(&timeout))
+        if (timeout <= 0.0 || !waitForEvent(&timeout))
             break;
     }
 
@@ -2395,13 +3775,47 @@ void _glfwPlatformPostEmptyEvent(void)
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
 {
     Window root, child;
-    int rootX, rootY, childX, childY;
+    int rootX, rootY, childX = 0, childY = 0;
     unsigned int mask;
 
-    XQueryPointer(_glfw.x11.display, window->x11.handle,
-                  &root, &child,
-                  &rootX, &rootY, &childX, &childY,
-                  &mask);
+    // The position from the last processed crossing or motion event is used
+    // while the cursor is known to be inside the window, avoiding a round trip
+    // Motion during a button grab may have left the cursor outside the window
+    // with no further events, so that position is not trusted
+    if (window->x11.cursorTracked && window->x11.cursorInside)
+    {
+        if (xpos)
+            *xpos = window->x11.lastCursorPosX;
+        if (ypos)
+            *ypos = window->x11.lastCursorPosY;
+
+        return;
+    }
+
+    if (_glfw.x11.xcb.connection)
+    {
+        xcb_generic_error_t* error = NULL;
+        const xcb_query_pointer_cookie_t cookie =
+            xcb_query_pointer(_glfw.x11.xcb.connection,
+                              (uint32_t) window->x11.handle);
+        xcb_query_pointer_reply_t* reply =
+            xcb_query_pointer_reply(_glfw.x11.xcb.connection, cookie, &error);
+        if (reply)
+        {
+            childX = reply->win_x;
+            childY = reply->win_y;
+            free(reply);
+        }
+
+        free(error);
+    }
+    else
+    {
+        XQueryPointer(_glfw.x11.display, window->x11.handle,
+                      &root, &child,
+                      &rootX, &rootY, &childX, &childY,
+                      &mask);
+    }
 
     if (xpos)
         *xpos = childX;
@@ -2415,6 +3829,9 @@ void _glfwPlatformSetCursorPos(_GLFWwindow* window, double x, double y)
     window->x11.warpCursorPosX = (int) x;
     window->x11.warpCursorPosY = (int) y;
 
+    // The cursor position is queried until the motion event of the warp
+    window->x11.cursorTracked = GLFW_FALSE;
+
     XWarpPointer(_glfw.x11.display, None, window->x11.handle,
                  0,0,0,0, (int) x, (int) y);
     XFlush(_glfw.x11.display);
@@ -2424,20 +3841,9 @@ void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode)
 {
     if (mode == GLFW_CURSOR_DISABLED)
     {
-        if (_glfw.x11.xi.available)
-        {
-            XIEventMask em;
-            unsigned char mask[XIMaskLen(XI_RawMotion)] = { 0 };
-
-            em.deviceid = XIAllMasterDevices;
-            em.mask_len = sizeof(mask);
-            em.mask = mask;
-            XISetMask(mask, XI_RawMotion);
-
-            XISelectEvents(_glfw.x11.display, _glfw.x11.root, &em, 1);
-        }
-
         _glfw.x11.disabledCursorWindow = window;
+        updateRawMotionSelection();
+
         _glfwPlatformGetCursorPos(window,
                                   &_glfw.x11.restoreCursorPosX,
                                   &_glfw.x11.restoreCursorPosY);
@@ -2451,19 +3857,9 @@ void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode)
     }
     else if (_glfw.x11.disabledCursorWindow == window)
     {
-        if (_glfw.x11.xi.available)
-        {
-            XIEventMask em;
-            unsigned char mask[] = { 0 };
-
-            em.deviceid = XIAllMasterDevices;
-            em.mask_len = sizeof(mask);
-            em.mask = mask;
-
-            XISelectEvents(_glfw.x11.display, _glfw.x11.root, &em, 1);
-        }
-
         _glfw.x11.disabledCursorWindow = NULL;
+        updateRawMotionSelection();
+
         XUngrabPointer(_glfw.x11.display, CurrentTime);
         _glfwPlatformSetCursorPos(window,
                                   _glfw.x11.restoreCursorPosX,
@@ -2474,6 +3870,23 @@ void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode)
     XFlush(_glfw.x11.display);
 }
 
+GLFWbool _glfwPlatformRawMouseMotionSupported(void)
+{
+    return _glfw.x11.xi.available;
+}
+
+void _glfwPlatformSetRawMouseMotion(_GLFWwindow* window, GLFWbool enabled)
+{
+    if (!enabled && _glfw.x11.xi.rawWindow == window)
+    {
+        _glfw.x11.xi.rawWindow = NULL;
+        _glfw.x11.xi.rawSampleCount = 0;
+    }
+
+    updateRawMotionSelection();
+    XFlush(_glfw.x11.display);
+}
+
 const char* _glfwPlatformGetKeyName(int key, int scancode)
 {
     if (!_glfw.x11.xkb.available)
@@ -2493,7 +3906,7 @@ const char* _glfwPlatformGetKeyName(int key, int scancode)
     if (ch == -1)
         return NULL;
 
-    const size_t count = encodeUTF8(_glfw.x11.keyName, (unsigned int) ch);
+    const size_t count = _glfwEncodeUTF8(_glfw.x11.keyName, (unsigned int) ch);
     if (count == 0)
         return NULL;
 
@@ -2510,31 +3923,51 @@ int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
                               const GLFWimage* image,
                               int xhot, int yhot)
 {
-    cursor->x11.handle = _glfwCreateCursorX11(image, xhot, yhot);
-    if (!cursor->x11.handle)
-        return GLFW_FALSE;
+    return createImageCursor(cursor, image, NULL, 1, xhot, yhot);
+}
 
-    return GLFW_TRUE;
+int _glfwPlatformCreateAnimatedCursor(_GLFWcursor* cursor,
+                                      const GLFWimage* frames,
+                                      const int* delays,
+                                      int count,
+                                      int xhot, int yhot)
+{
+    return createImageCursor(cursor, frames, delays, count, xhot, yhot);
 }
 
 int _glfwPlatformCreateStandardCursor(_GLFWcursor* cursor, int shape)
 {
-    cursor->x11.handle = XCreateFontCursor(_glfw.x11.display,
-                                           translateCursorShape(shape));
-    if (!cursor->x11.handle)
+    _GLFWsharedcursorX11* shared = findSharedCursor(shape, NULL, 0, 0);
+    if (shared)
+        shared->refCount++;
+    else
     {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "X11: Failed to create standard cursor");
-        return GLFW_FALSE;
+        const Cursor handle = XCreateFontCursor(_glfw.x11.display,
+                                                translateCursorShape(shape));
+        if (!handle)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "X11: Failed to create standard cursor");
+            return GLFW_FALSE;
+        }
+
+        shared = addSharedCursor(handle, shape, NULL, 0, 0);
+        if (!shared)
+        {
+            XFreeCursor(_glfw.x11.display, handle);
+            return GLFW_FALSE;
+        }
     }
 
+    cursor->x11.shared = shared;
+    cursor->x11.handle = shared->handle;
     return GLFW_TRUE;
 }
 
 void _glfwPlatformDestroyCursor(_GLFWcursor* cursor)
 {
-    if (cursor->x11.handle)
-        XFreeCursor(_glfw.x11.display, cursor->x11.handle);
+    if (cursor->x11.shared)
+        releaseSharedCursor(cursor->x11.shared);
 }
 
 void _glfwPlatformSetCursor(_GLFWwindow* window, _GLFWcursor* cursor)
@@ -2548,90 +3981,154 @@ void _glfwPlatformSetCursor(_GLFWwindow* window, _GLFWcursor* cursor)
 
 void _glfwPlatformSetClipboardString(_GLFWwindow* window, const char* string)
 {
+    clearSelectionData();
     free(_glfw.x11.clipboardString);
     _glfw.x11.clipboardString = strdup(string);
+    _glfw.x11.clipboardLength = strlen(string);
 
-    XSetSelectionOwner(_glfw.x11.display,
-                       _glfw.x11.CLIPBOARD,
-                       _glfw.x11.helperWindowHandle,
-                       CurrentTime);
-
-    if (XGetSelectionOwner(_glfw.x11.display, _glfw.x11.CLIPBOARD) !=
-        _glfw.x11.helperWindowHandle)
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "X11: Failed to become owner of clipboard selection");
-    }
+    acquireClipboard();
 }
 
 const char* _glfwPlatformGetClipboardString(_GLFWwindow* window)
 {
-    size_t i;
-    const Atom formats[] = { _glfw.x11.UTF8_STRING,
-                             _glfw.x11.COMPOUND_STRING,
-                             XA_STRING };
-    const size_t formatCount = sizeof(formats) / sizeof(formats[0]);
-
     if (XGetSelectionOwner(_glfw.x11.display, _glfw.x11.CLIPBOARD) ==
         _glfw.x11.helperWindowHandle)
     {
         // Instead of doing a large number of X round-trips just to put this
         // string into a window property and then read it back, just return it
+        if (!_glfw.x11.clipboardString)
+        {
+            _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                            "X11: Failed to convert clipboard to string");
+        }
+
         return _glfw.x11.clipboardString;
     }
 
     free(_glfw.x11.clipboardString);
     _glfw.x11.clipboardString = NULL;
 
-    for (i = 0;  i < formatCount;  i++)
+    // A transfer for another kind of request must end before this one starts
+    if (_glfw.x11.transfer.request != _GLFW_REQUEST_STRING)
+        waitForTransfer();
+
+    if (_glfw.x11.transfer.state == _GLFW_TRANSFER_NONE)
+        startTransfer(_GLFW_REQUEST_STRING, _glfw.x11.TARGETS);
+
+    _glfw.x11.transfer.blocking = GLFW_TRUE;
+    waitForTransfer();
+    _glfw.x11.transfer.blocking = GLFW_FALSE;
+
+    return _glfw.x11.clipboardString;
+}
+
+void _glfwPlatformRequestClipboardString(_GLFWwindow* window)
+{
+    if (XGetSelectionOwner(_glfw.x11.display, _glfw.x11.CLIPBOARD) ==
+        _glfw.x11.helperWindowHandle)
     {
-        char* data;
-        XEvent event;
+        // The callbacks may replace the clipboard string, so pass a copy
+        char* string = NULL;
+        if (_glfw.x11.clipboardString)
+            string = strdup(_glfw.x11.clipboardString);
 
-        XConvertSelection(_glfw.x11.display,
-                          _glfw.x11.CLIPBOARD,
-                          formats[i],
-                          _glfw.x11.GLFW_SELECTION,
-                          _glfw.x11.helperWindowHandle,
-                          CurrentTime);
+        _glfwInputClipboardString(string);
+        free(string);
+        return;
+    }
 
-        while (!XCheckTypedWindowEvent(_glfw.x11.display,
-                                       _glfw.x11.helperWindowHandle,
-                                       SelectionNotify,
-                                       &event))
-        {
-            waitForEvent(NULL);
-        }
+    if (_glfw.x11.transfer.request != _GLFW_REQUEST_STRING)
+        waitForTransfer();
 
-        if (event.xselection.property == None)
-            continue;
+    if (_glfw.x11.transfer.state == _GLFW_TRANSFER_NONE)
+        startTransfer(_GLFW_REQUEST_STRING, _glfw.x11.TARGETS);
+}
 
-        if (_glfwGetWindowPropertyX11(event.xselection.requestor,
-                                      event.xselection.property,
-                                      event.xselection.target,
-                                      (unsigned char**) &data))
-        {
-            _glfw.x11.clipboardString = strdup(data);
-        }
+void _glfwPlatformSetClipboardData(_GLFWwindow* window)
+{
+    clearSelectionData();
+    free(_glfw.x11.clipboardString);
+    _glfw.x11.clipboardString = NULL;
 
-        if (data)
-            XFree(data);
+    // The target atoms are looked up once for all later requests
+    _glfw.x11.clipboardTargets = calloc(_glfw.clipboard.count, sizeof(Atom));
+    XInternAtoms(_glfw.x11.display,
+                 (char**) _glfw.clipboard.names,
+                 _glfw.clipboard.count,
+                 False,
+                 _glfw.x11.clipboardTargets);
 
-        XDeleteProperty(_glfw.x11.display,
-                        event.xselection.requestor,
-                        event.xselection.property);
+    acquireClipboard();
+}
+
+const char** _glfwPlatformGetClipboardTypes(_GLFWwindow* window, int* count)
+{
+    int i;
+
+    for (i = 0;  i < _glfw.x11.clipboardTypeCount;  i++)
+        free(_glfw.x11.clipboardTypes[i]);
+
+    free(_glfw.x11.clipboardTypes);
+    _glfw.x11.clipboardTypes = NULL;
+    _glfw.x11.clipboardTypeCount = 0;
+
+    if (XGetSelectionOwner(_glfw.x11.display, _glfw.x11.CLIPBOARD) ==
+        _glfw.x11.helperWindowHandle)
+    {
+        static const char* stringTypes[] =
+        {
+            "UTF8_STRING",
+            "COMPOUND_STRING",
+            "STRING"
+        };
 
         if (_glfw.x11.clipboardString)
-            break;
+        {
+            *count = sizeof(stringTypes) / sizeof(stringTypes[0]);
+            return stringTypes;
+        }
+
+        *count = _glfw.clipboard.count;
+        return _glfw.clipboard.names;
     }
 
-    if (_glfw.x11.clipboardString == NULL)
+    waitForTransfer();
+    startTransfer(_GLFW_REQUEST_TYPES, _glfw.x11.TARGETS);
+    waitForTransfer();
+
+    *count = _glfw.x11.clipboardTypeCount;
+    return (const char**) _glfw.x11.clipboardTypes;
+}
+
+const void* _glfwPlatformGetClipboardData(_GLFWwindow* window,
+                                          const char* type,
+                                          size_t* size)
+{
+    const Atom target = XInternAtom(_glfw.x11.display, type, False);
+
+    free(_glfw.x11.clipboardData);
+    _glfw.x11.clipboardData = NULL;
+    _glfw.x11.clipboardDataSize = 0;
+
+    if (XGetSelectionOwner(_glfw.x11.display, _glfw.x11.CLIPBOARD) ==
+        _glfw.x11.helperWindowHandle)
     {
-        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
-                        "X11: Failed to convert clipboard to string");
+        const char* data = getSelectionData(target, size);
+        if (!data)
+        {
+            _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                            "X11: Clipboard data not available as %s", type);
+        }
+
+        return data;
     }
 
-    return _glfw.x11.clipboardString;
+    waitForTransfer();
+    startTransfer(_GLFW_REQUEST_DATA, target);
+    waitForTransfer();
+
+    *size = _glfw.x11.clipboardDataSize;
+    return _glfw.x11.clipboardData;
 }
 
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
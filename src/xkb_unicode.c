@@ -27,6 +27,8 @@
 
 #include "internal.h"
 
+#include <assert.h>
+
 
 /*
  * Marcus: This code was originally written by Markus G. Kuhn.
@@ -40,8 +42,8 @@
  *
  * The array keysymtab[] contains pairs of X11 keysym values for graphical
  * characters and the corresponding Unicode value. The function
- * _glfwKeySym2Unicode() maps a keysym onto a Unicode value using a binary
- * search, therefore keysymtab[] must remain SORTED by keysym value.
+ * _glfwKeySym2Unicode() maps a keysym onto a Unicode value using a direct
+ * lookup table built from keysymtab[] on first use.
  *
  * We allow to represent any UCS character in the range U-00000000 to
  * U-00FFFFFF by a keysym value in the range 0x01000000 to 0x01ffffff.
@@ -898,6 +900,38 @@ static const struct codepair {
   { 0xffbd /*XKB_KEY_KP_Equal*/,     '=' }
 };
 
+// The number of distinct keysym high bytes in keysymtab, plus the empty page
+#define _GLFW_KEYSYM_PAGE_COUNT 19
+
+// Direct lookup table, indexed first by the keysym high byte and then by the
+// low byte, where a UCS value of zero means there is no mapping
+static unsigned char keysymPages[256];
+static unsigned short ucsPages[_GLFW_KEYSYM_PAGE_COUNT][256];
+static GLFWbool ucsPagesBuilt = GLFW_FALSE;
+
+// Builds the direct lookup table from keysymtab
+//
+static void buildUCSPages(void)
+{
+    int i, pageCount = 1;
+
+    for (i = 0;  i < (int) (sizeof(keysymtab) / sizeof(keysymtab[0]));  i++)
+    {
+        const int high = keysymtab[i].keysym >> 8;
+
+        if (!keysymPages[high])
+        {
+            assert(pageCount < _GLFW_KEYSYM_PAGE_COUNT);
+            keysymPages[high] = (unsigned char) pageCount++;
+        }
+
+        ucsPages[keysymPages[high]][keysymtab[i].keysym & 0xff] =
+            keysymtab[i].ucs;
+    }
+
+    ucsPagesBuilt = GLFW_TRUE;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -907,9 +941,7 @@ static const struct codepair {
 //
 long _glfwKeySym2Unicode(unsigned int keysym)
 {
-    int min = 0;
-    int max = sizeof(keysymtab) / sizeof(struct codepair) - 1;
-    int mid;
+    unsigned short ucs;
 
     // First check for Latin-1 characters (1:1 mapping)
     if ((keysym >= 0x0020 && keysym <= 0x007e) ||
@@ -922,17 +954,16 @@ long _glfwKeySym2Unicode(unsigned int keysym)
     if ((keysym & 0xff000000) == 0x01000000)
         return keysym & 0x00ffffff;
 
-    // Binary search in table
-    while (max >= min)
-    {
-        mid = (min + max) / 2;
-        if (keysymtab[mid].keysym < keysym)
-            min = mid + 1;
-        else if (keysymtab[mid].keysym > keysym)
-            max = mid - 1;
-        else
-            return keysymtab[mid].ucs;
-    }
+    // All other keysyms in the table fit in 16 bits
+    if (keysym > 0xffff)
+        return -1;
+
+    if (!ucsPagesBuilt)
+        buildUCSPages();
+
+    ucs = ucsPages[keysymPages[keysym >> 8]][keysym & 0xff];
+    if (ucs)
+        return ucs;
 
     // No matching Unicode value found
     return -1;
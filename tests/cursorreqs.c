@@ -0,0 +1,172 @@
+//========================================================================
+// Disabled cursor X request counter
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test moves the pointer before each call to glfwPollEvents and counts
+// the X requests made by that call, first with the normal cursor mode and then
+// with the disabled cursor mode, and reports the average number of requests
+// per frame for each
+//
+// With XInput 2 available, a disabled cursor must not make any more requests
+// per frame than a normal one, so the test fails if it does
+//
+// It requires GLFW to be built for X11
+//
+//========================================================================
+
+#include <GLFW/glfw3.h>
+
+#define GLFW_EXPOSE_NATIVE_X11
+#include <GLFW/glfw3native.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: cursorreqs [-h] [-n FRAMES]\n");
+    printf("Options:\n");
+    printf("  -n the number of frames to count for each mode (default 600)\n");
+    printf("  -h show this help\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+// Returns the average number of X requests made by glfwPollEvents after the
+// pointer has moved within the window
+//
+static double count_requests(Display* display, Window handle, int frames)
+{
+    int i;
+    unsigned long requests = 0;
+
+    for (i = 0;  i < frames;  i++)
+    {
+        unsigned long first;
+
+        // Move away from the center, where recentering would be skipped, and
+        // wait for the resulting motion event to arrive before polling
+        XWarpPointer(display, None, handle, 0, 0, 0, 0,
+                     100 + (i % 2) * 50, 100 + (i % 3) * 50);
+        XSync(display, False);
+
+        first = XNextRequest(display);
+        glfwPollEvents();
+        requests += XNextRequest(display) - first;
+    }
+
+    return (double) requests / frames;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, frames = 600, supported;
+    double normal, disabled;
+    Display* display;
+    Window handle;
+    GLFWwindow* window;
+
+    while ((ch = getopt(argc, argv, "hn:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                frames = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (frames < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    // Raw motion is supported exactly when XInput 2 is available
+    supported = glfwRawMouseMotionSupported();
+
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+
+    window = glfwCreateWindow(640, 480, "Disabled Cursor Requests", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    display = glfwGetX11Display();
+    handle = glfwGetX11Window(window);
+
+    // Let the window be mapped and focused before counting, as the cursor is
+    // only disabled while the window has focus
+    glfwFocusWindow(window);
+    XSync(display, False);
+    glfwPollEvents();
+
+    normal = count_requests(display, handle, frames);
+
+    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    XSync(display, False);
+    glfwPollEvents();
+
+    disabled = count_requests(display, handle, frames);
+
+    printf("Normal cursor:   %.2f requests per frame\n", normal);
+    printf("Disabled cursor: %.2f requests per frame\n", disabled);
+
+    glfwTerminate();
+
+    // Without XInput 2 the disabled cursor is still recentered every frame
+    if (!supported)
+    {
+        printf("XInput 2 is not available, so the counts are not compared\n");
+        exit(EXIT_SUCCESS);
+    }
+
+    if (disabled > normal)
+    {
+        printf("The disabled cursor makes more requests than the normal one\n");
+        exit(EXIT_FAILURE);
+    }
+
+    exit(EXIT_SUCCESS);
+}
@@ -358,6 +358,24 @@ static void cursor_enter_callback(GLFWwindow* window, int entered)
            entered ? "entered" : "left");
 }
 
+static void raw_motion_callback(GLFWwindow* window,
+                                const GLFWrawmotion* samples,
+                                int count)
+{
+    int i;
+    double dx = 0.0, dy = 0.0;
+    Slot* slot = glfwGetWindowUserPointer(window);
+
+    for (i = 0;  i < count;  i++)
+    {
+        dx += samples[i].dx;
+        dy += samples[i].dy;
+    }
+
+    printf("%08x to %i at %0.3f: Raw motion: %i samples totaling %f %f\n",
+           counter++, slot->number, glfwGetTime(), count, dx, dy);
+}
+
 static void scroll_callback(GLFWwindow* window, double x, double y)
 {
     Slot* slot = glfwGetWindowUserPointer(window);
@@ -400,6 +418,18 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
             printf("(( closing %s ))\n", slot->closeable ? "enabled" : "disabled");
             break;
         }
+
+        case GLFW_KEY_R:
+        {
+            if (glfwRawMouseMotionSupported())
+            {
+                const int raw = !glfwGetInputMode(window, GLFW_RAW_MOUSE_MOTION);
+                glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, raw);
+
+                printf("(( raw mouse motion %s ))\n", raw ? "enabled" : "disabled");
+            }
+            break;
+        }
     }
 }
 
@@ -420,6 +450,13 @@ static void char_mods_callback(GLFWwindow* window, unsigned int codepoint, int m
             get_mods_name(mods));
 }
 
+static void text_callback(GLFWwindow* window, const char* text)
+{
+    Slot* slot = glfwGetWindowUserPointer(window);
+    printf("%08x to %i at %0.3f: Text \"%s\" input\n",
+           counter++, slot->number, glfwGetTime(), text);
+}
+
 static void drop_callback(GLFWwindow* window, int count, const char** paths)
 {
     int i;
@@ -594,10 +631,12 @@ int main(int argc, char** argv)
         glfwSetMouseButtonCallback(slots[i].window, mouse_button_callback);
         glfwSetCursorPosCallback(slots[i].window, cursor_position_callback);
         glfwSetCursorEnterCallback(slots[i].window, cursor_enter_callback);
+        glfwSetRawMotionCallback(slots[i].window, raw_motion_callback);
         glfwSetScrollCallback(slots[i].window, scroll_callback);
         glfwSetKeyCallback(slots[i].window, key_callback);
         glfwSetCharCallback(slots[i].window, char_callback);
         glfwSetCharModsCallback(slots[i].window, char_mods_callback);
+        glfwSetTextCallback(slots[i].window, text_callback);
         glfwSetDropCallback(slots[i].window, drop_callback);
 
         glfwMakeContextCurrent(slots[i].window);
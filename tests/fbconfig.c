@@ -0,0 +1,355 @@
+//========================================================================
+// Framebuffer config selection test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test compares the framebuffer config selection with the unpruned
+// scoring loop it replaced, on randomized sets of 500 to 2000 configs drawn
+// from a few common channel sizes so that many configs tie, and then times
+// both over the same sets
+//
+// The selection is internal to GLFW, so its source is compiled into the test
+//
+//========================================================================
+
+// The context functions are defined by the test, not imported from GLFW
+#undef GLFW_DLL
+
+#include "context.c"
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SET_COUNT 2000
+
+// The test only uses the config selection, which needs none of these
+_GLFWlibrary _glfw;
+
+void _glfwInputError(int code, const char* format, ...)
+{
+}
+
+void* _glfwPlatformGetTls(_GLFWtls* tls)
+{
+    return NULL;
+}
+
+// Selects a config with the scoring loop GLFW used to
+//
+static const _GLFWfbconfig* referenceChooseFBConfig(const _GLFWfbconfig* desired,
+                                                    const _GLFWfbconfig* alternatives,
+                                                    unsigned int count)
+{
+    unsigned int i;
+    unsigned int missing, leastMissing = UINT_MAX;
+    unsigned int colorDiff, leastColorDiff = UINT_MAX;
+    unsigned int extraDiff, leastExtraDiff = UINT_MAX;
+    const _GLFWfbconfig* current;
+    const _GLFWfbconfig* closest = NULL;
+
+    for (i = 0;  i < count;  i++)
+    {
+        current = alternatives + i;
+
+        if (desired->stereo > 0 && current->stereo == 0)
+        {
+            // Stereo is a hard constraint
+            continue;
+        }
+
+        if (desired->doublebuffer != current->doublebuffer)
+        {
+            // Double buffering is a hard constraint
+            continue;
+        }
+
+        // Count number of missing buffers
+        {
+            missing = 0;
+
+            if (desired->alphaBits > 0 && current->alphaBits == 0)
+                missing++;
+
+            if (desired->depthBits > 0 && current->depthBits == 0)
+                missing++;
+
+            if (desired->stencilBits > 0 && current->stencilBits == 0)
+                missing++;
+
+            if (desired->auxBuffers > 0 &&
+                current->auxBuffers < desired->auxBuffers)
+            {
+                missing += desired->auxBuffers - current->auxBuffers;
+            }
+
+            if (desired->samples > 0 && current->samples == 0)
+            {
+                // Technically, several multisampling buffers could be
+                // involved, but that's a lower level implementation detail and
+                // not important to us here, so we count them as one
+                missing++;
+            }
+        }
+
+        // These polynomials make many small channel size differences matter
+        // less than one large channel size difference
+
+        // Calculate color channel size difference value
+        {
+            colorDiff = 0;
+
+            if (desired->redBits != GLFW_DONT_CARE)
+            {
+                colorDiff += (desired->redBits - current->redBits) *
+                             (desired->redBits - current->redBits);
+            }
+
+            if (desired->greenBits != GLFW_DONT_CARE)
+            {
+                colorDiff += (desired->greenBits - current->greenBits) *
+                             (desired->greenBits - current->greenBits);
+            }
+
+            if (desired->blueBits != GLFW_DONT_CARE)
+            {
+                colorDiff += (desired->blueBits - current->blueBits) *
+                             (desired->blueBits - current->blueBits);
+            }
+        }
+
+        // Calculate non-color channel size difference value
+        {
+            extraDiff = 0;
+
+            if (desired->alphaBits != GLFW_DONT_CARE)
+            {
+                extraDiff += (desired->alphaBits - current->alphaBits) *
+                             (desired->alphaBits - current->alphaBits);
+            }
+
+            if (desired->depthBits != GLFW_DONT_CARE)
+            {
+                extraDiff += (desired->depthBits - current->depthBits) *
+                             (desired->depthBits - current->depthBits);
+            }
+
+            if (desired->stencilBits != GLFW_DONT_CARE)
+            {
+                extraDiff += (desired->stencilBits - current->stencilBits) *
+                             (desired->stencilBits - current->stencilBits);
+            }
+
+            if (desired->accumRedBits != GLFW_DONT_CARE)
+            {
+                extraDiff += (desired->accumRedBits - current->accumRedBits) *
+                             (desired->accumRedBits - current->accumRedBits);
+            }
+
+            if (desired->accumGreenBits != GLFW_DONT_CARE)
+            {
+                extraDiff += (desired->accumGreenBits - current->accumGreenBits) *
+                             (desired->accumGreenBits - current->accumGreenBits);
+            }
+
+            if (desired->accumBlueBits != GLFW_DONT_CARE)
+            {
+                extraDiff += (desired->accumBlueBits - current->accumBlueBits) *
+                             (desired->accumBlueBits - current->accumBlueBits);
+            }
+
+            if (desired->accumAlphaBits != GLFW_DONT_CARE)
+            {
+                extraDiff += (desired->accumAlphaBits - current->accumAlphaBits) *
+                             (desired->accumAlphaBits - current->accumAlphaBits);
+            }
+
+            if (desired->samples != GLFW_DONT_CARE)
+            {
+                extraDiff += (desired->samples - current->samples) *
+                             (desired->samples - current->samples);
+            }
+
+            if (desired->sRGB && !current->sRGB)
+                extraDiff++;
+        }
+
+        // Figure out if the current one is better than the best one found so far
+        // Least number of missing buffers is the most important heuristic,
+        // then color buffer size match and lastly size match for other buffers
+
+        if (missing < leastMissing)
+            closest = current;
+        else if (missing == leastMissing)
+        {
+            if ((colorDiff < leastColorDiff) ||
+                (colorDiff == leastColorDiff && extraDiff < leastExtraDiff))
+            {
+                closest = current;
+            }
+        }
+
+        if (current == closest)
+        {
+            leastMissing = missing;
+            leastColorDiff = colorDiff;
+            leastExtraDiff = extraDiff;
+        }
+    }
+
+    return closest;
+}
+
+// Returns a random element of the specified array
+//
+static int pick(const int* values, int count)
+{
+    return values[rand() % count];
+}
+
+// Fills the specified config with random but common channel sizes
+//
+static void randomConfig(_GLFWfbconfig* config)
+{
+    const int colors[] = { 0, 5, 8, 8, 10, 16 };
+    const int alphas[] = { 0, 0, 2, 8, 8 };
+    const int depths[] = { 0, 16, 24, 24, 32 };
+    const int stencils[] = { 0, 8 };
+    const int accums[] = { 0, 0, 16 };
+    const int auxes[] = { 0, 0, 0, 1, 2, 4 };
+    const int samples[] = { 0, 0, 2, 4, 8, 16 };
+
+    memset(config, 0, sizeof(_GLFWfbconfig));
+    config->redBits = pick(colors, 6);
+    config->greenBits = pick(colors, 6);
+    config->blueBits = pick(colors, 6);
+    config->alphaBits = pick(alphas, 5);
+    config->depthBits = pick(depths, 5);
+    config->stencilBits = pick(stencils, 2);
+    config->accumRedBits = pick(accums, 3);
+    config->accumGreenBits = pick(accums, 3);
+    config->accumBlueBits = pick(accums, 3);
+    config->accumAlphaBits = pick(accums, 3);
+    config->auxBuffers = pick(auxes, 6);
+    config->samples = pick(samples, 6);
+    config->stereo = (rand() % 8) == 0;
+    config->sRGB = rand() % 2;
+    config->doublebuffer = (rand() % 4) != 0;
+}
+
+// Replaces some fields of the specified desired config with don't care
+//
+static void randomDontCare(_GLFWfbconfig* desired)
+{
+    int* fields[] =
+    {
+        &desired->redBits, &desired->greenBits, &desired->blueBits,
+        &desired->alphaBits, &desired->depthBits, &desired->stencilBits,
+        &desired->accumRedBits, &desired->accumGreenBits,
+        &desired->accumBlueBits, &desired->accumAlphaBits,
+        &desired->samples
+    };
+    int i;
+
+    for (i = 0;  i < (int) (sizeof(fields) / sizeof(fields[0]));  i++)
+    {
+        if (rand() % 4 == 0)
+            *fields[i] = GLFW_DONT_CARE;
+    }
+}
+
+int main(void)
+{
+    const int trials = 2000;
+    int i, j;
+    unsigned long mismatches = 0, exact = 0;
+    double reference = 0.0, pruned = 0.0;
+    _GLFWfbconfig* configs = calloc(SET_COUNT, sizeof(_GLFWfbconfig));
+
+    srand(1);
+
+    for (i = 0;  i < trials;  i++)
+    {
+        _GLFWfbconfig desired;
+        const _GLFWfbconfig* expected;
+        const _GLFWfbconfig* actual;
+        const unsigned int count = 500 + rand() % (SET_COUNT - 500 + 1);
+        clock_t start;
+
+        for (j = 0;  j < (int) count;  j++)
+            randomConfig(configs + j);
+
+        // Some sets contain an exact match, which ends the pruned search
+        if (i % 4 == 0)
+            desired = configs[rand() % count];
+        else
+        {
+            randomConfig(&desired);
+            randomDontCare(&desired);
+        }
+
+        start = clock();
+        for (j = 0;  j < 10;  j++)
+            expected = referenceChooseFBConfig(&desired, configs, count);
+        reference += (double) (clock() - start) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (j = 0;  j < 10;  j++)
+            actual = _glfwChooseFBConfig(&desired, configs, count);
+        pruned += (double) (clock() - start) / CLOCKS_PER_SEC;
+
+        // The first of several equally close configs must still be chosen
+        if (expected != actual)
+        {
+            if (mismatches < 10)
+            {
+                printf("Set %i of %u configs: expected config %i, got config %i\n",
+                       i, count,
+                       expected ? (int) (expected - configs) : -1,
+                       actual ? (int) (actual - configs) : -1);
+            }
+
+            mismatches++;
+        }
+
+        if (expected && memcmp(expected, &desired, sizeof(desired)) == 0)
+            exact++;
+    }
+
+    free(configs);
+
+    if (mismatches)
+    {
+        printf("%lu of %i sets selected differently\n", mismatches, trials);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("All %i sets selected identically (%lu exact matches)\n",
+           trials, exact);
+    printf("Reference: %.2f us per selection\n",
+           reference * 1e6 / (trials * 10.0));
+    printf("Pruned:    %.2f us per selection\n",
+           pruned * 1e6 / (trials * 10.0));
+
+    exit(EXIT_SUCCESS);
+}
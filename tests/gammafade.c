@@ -0,0 +1,162 @@
+//========================================================================
+// Gamma fade benchmark
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This benchmark fades the gamma of the primary monitor to a dimmed, warm
+// night mode and back with one gamma adjustment per 60 Hz frame, and reports
+// the time spent per frame, both for frames that change the ramp and for
+// frames that repeat it
+//
+// The frames are not paced, so the fade runs as fast as the ramps are set
+// The original gamma ramp is restored afterwards
+//
+//========================================================================
+
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: gammafade [-h] [-s SECONDS]\n");
+    printf("Options:\n");
+    printf("  -s the length of the fade in each direction (default 2)\n");
+    printf("  -h show this help\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+// Sets the adjustment for the specified position of the fade, from zero for
+// no adjustment to one for full night mode
+//
+static void set_fade(GLFWmonitor* monitor, float t)
+{
+    glfwSetGammaAdjustment(monitor, 1.f, 1.f, 1.f,
+                           1.f - 0.5f * t,
+                           6500.f - 3100.f * t);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, frames, seconds = 2;
+    double start, changed, repeated;
+    GLFWmonitor* monitor;
+    const GLFWgammaramp* ramp;
+    GLFWgammaramp original;
+
+    while ((ch = getopt(argc, argv, "hs:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 's':
+                seconds = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (seconds < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    monitor = glfwGetPrimaryMonitor();
+    if (!monitor)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    ramp = glfwGetGammaRamp(monitor);
+    if (!ramp)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    // The returned ramp is only valid until the next gamma call
+    original.size = ramp->size;
+    original.red = calloc(ramp->size, sizeof(unsigned short));
+    original.green = calloc(ramp->size, sizeof(unsigned short));
+    original.blue = calloc(ramp->size, sizeof(unsigned short));
+    memcpy(original.red, ramp->red, ramp->size * sizeof(unsigned short));
+    memcpy(original.green, ramp->green, ramp->size * sizeof(unsigned short));
+    memcpy(original.blue, ramp->blue, ramp->size * sizeof(unsigned short));
+
+    printf("Fading %s with a %u element ramp\n",
+           glfwGetMonitorName(monitor), original.size);
+
+    frames = seconds * 60;
+
+    start = glfwGetTime();
+
+    for (i = 0;  i <= frames;  i++)
+        set_fade(monitor, (float) i / frames);
+    for (i = frames;  i >= 0;  i--)
+        set_fade(monitor, (float) i / frames);
+
+    changed = (glfwGetTime() - start) / (2 * (frames + 1));
+
+    // A held adjustment sets the same ramp every frame
+    start = glfwGetTime();
+
+    for (i = 0;  i < frames;  i++)
+        set_fade(monitor, 0.f);
+
+    repeated = (glfwGetTime() - start) / frames;
+
+    printf("Changing frames:  %.3f ms (%.2f%% of a 60 Hz frame)\n",
+           changed * 1000.0, changed * 6000.0);
+    printf("Repeated frames:  %.3f ms (%.2f%% of a 60 Hz frame)\n",
+           repeated * 1000.0, repeated * 6000.0);
+
+    glfwSetGammaRamp(monitor, &original);
+
+    free(original.red);
+    free(original.green);
+    free(original.blue);
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
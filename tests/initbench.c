@@ -0,0 +1,129 @@
+//========================================================================
+// Initialization time benchmark
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This benchmark initializes and terminates GLFW repeatedly and reports the
+// shortest, average and longest time taken by glfwInit
+//
+// Initialization is dominated by round trips to the window system, so it is
+// most informative over a slow connection.  On X11 the latency can be added
+// by running Xvfb with TCP enabled and delaying the loopback interface, for
+// example:
+//
+//   Xvfb :9 -listen tcp &
+//   tc qdisc add dev lo root netem delay 10ms
+//   DISPLAY=localhost:9 ./initbench
+//
+//========================================================================
+
+#include "tinycthread.h"
+
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: initbench [-h] [-n COUNT]\n");
+    printf("Options:\n");
+    printf("  -n the number of times to initialize GLFW (default 10)\n");
+    printf("  -h show this help\n");
+}
+
+// Returns the current time in seconds
+// The GLFW timer is not available while the library is not initialized
+//
+static double get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, count = 10;
+    double total = 0.0, shortest = 0.0, longest = 0.0;
+
+    while ((ch = getopt(argc, argv, "hn:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                count = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (count < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    for (i = 0;  i < count;  i++)
+    {
+        double start, elapsed;
+
+        start = get_time();
+
+        if (!glfwInit())
+            exit(EXIT_FAILURE);
+
+        elapsed = get_time() - start;
+
+        glfwTerminate();
+
+        total += elapsed;
+        if (i == 0 || elapsed < shortest)
+            shortest = elapsed;
+        if (i == 0 || elapsed > longest)
+            longest = elapsed;
+    }
+
+    printf("glfwInit over %i runs:\n", count);
+    printf("  Shortest: %.2f ms\n", shortest * 1000.0);
+    printf("  Average:  %.2f ms\n", total * 1000.0 / count);
+    printf("  Longest:  %.2f ms\n", longest * 1000.0);
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,151 @@
+//========================================================================
+// Null platform input throughput benchmark
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This benchmark injects synthetic key and cursor motion events with the
+// null platform injection API and reports how many events per second are
+// queued and dispatched through the shared input code
+//
+// It requires GLFW to be built for the null platform (GLFW_USE_OSMESA)
+//
+//========================================================================
+
+#include <GLFW/glfw3.h>
+
+#define GLFW_EXPOSE_NATIVE_NULL
+#include <GLFW/glfw3native.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+// Events injected before each poll, which bounds the size of the queue
+#define BATCH_SIZE 4096
+
+static unsigned long received = 0;
+
+static void usage(void)
+{
+    printf("Usage: inputbench [-h] [-n COUNT]\n");
+    printf("Options:\n");
+    printf("  -n the number of events to inject (default 4000000)\n");
+    printf("  -h show this help\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    received++;
+}
+
+static void cursor_position_callback(GLFWwindow* window, double x, double y)
+{
+    received++;
+}
+
+int main(int argc, char** argv)
+{
+    int ch;
+    unsigned long i, count = 4000000;
+    double start, injectTime = 0.0, dispatchTime = 0.0;
+    GLFWwindow* window;
+
+    while ((ch = getopt(argc, argv, "hn:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                count = strtoul(optarg, NULL, 10);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+
+    window = glfwCreateWindow(640, 480, "Input Benchmark", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetKeyCallback(window, key_callback);
+    glfwSetCursorPosCallback(window, cursor_position_callback);
+
+    for (i = 0;  i < count;  )
+    {
+        const unsigned long end = (count - i < BATCH_SIZE) ? count : i + BATCH_SIZE;
+
+        start = glfwGetTime();
+
+        for (;  i < end;  i++)
+        {
+            // Alternate between presses, releases and distinct cursor positions
+            // so no event is filtered out as a duplicate
+            if (i % 2)
+                glfwInjectNullCursorPos(window, (double) (i % 640), (double) (i % 480));
+            else
+            {
+                glfwInjectNullKey(window, GLFW_KEY_A, 38,
+                                  (i % 4) ? GLFW_RELEASE : GLFW_PRESS, 0);
+            }
+        }
+
+        injectTime += glfwGetTime() - start;
+
+        start = glfwGetTime();
+        glfwPollEvents();
+        dispatchTime += glfwGetTime() - start;
+    }
+
+    printf("%lu events injected, %lu received\n", count, received);
+
+    if (injectTime > 0.0)
+        printf("Injection: %.0f events/s\n", count / injectTime);
+    if (dispatchTime > 0.0)
+        printf("Dispatch:  %.0f events/s\n", count / dispatchTime);
+    if (injectTime + dispatchTime > 0.0)
+        printf("Total:     %.0f events/s\n", count / (injectTime + dispatchTime));
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,150 @@
+//========================================================================
+// Keysym to Unicode table test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test compares the keysym to Unicode lookup table with a binary search
+// of the keysym table it is built from, for every keysym that can reach the
+// table and the neighboring ranges, and then times both over all 16-bit
+// keysyms
+//
+// The conversion is internal to GLFW, so its source is compiled into the test
+//
+//========================================================================
+
+#include "xkb_unicode.c"
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Converts a keysym by binary search of the keysym table, as GLFW used to
+//
+static long referenceKeySym2Unicode(unsigned int keysym)
+{
+    int min = 0;
+    int max = sizeof(keysymtab) / sizeof(struct codepair) - 1;
+    int mid;
+
+    if ((keysym >= 0x0020 && keysym <= 0x007e) ||
+        (keysym >= 0x00a0 && keysym <= 0x00ff))
+    {
+        return keysym;
+    }
+
+    if ((keysym & 0xff000000) == 0x01000000)
+        return keysym & 0x00ffffff;
+
+    while (max >= min)
+    {
+        mid = (min + max) / 2;
+        if (keysymtab[mid].keysym < keysym)
+            min = mid + 1;
+        else if (keysymtab[mid].keysym > keysym)
+            max = mid - 1;
+        else
+            return keysymtab[mid].ucs;
+    }
+
+    return -1;
+}
+
+// Compares both conversions over the specified inclusive range of keysyms
+//
+static unsigned long compareRange(unsigned int first, unsigned int last)
+{
+    unsigned int keysym = first;
+    unsigned long mismatches = 0;
+
+    for (;;)
+    {
+        const long expected = referenceKeySym2Unicode(keysym);
+        const long actual = _glfwKeySym2Unicode(keysym);
+
+        if (expected != actual)
+        {
+            if (mismatches < 10)
+            {
+                printf("Keysym 0x%08x: expected %ld, got %ld\n",
+                       keysym, expected, actual);
+            }
+
+            mismatches++;
+        }
+
+        if (keysym == last)
+            break;
+
+        keysym++;
+    }
+
+    return mismatches;
+}
+
+// Times the specified conversion over all 16-bit keysyms
+//
+static double timeSweep(long (*convert)(unsigned int), int passes)
+{
+    int i;
+    unsigned int keysym;
+    volatile long sink = 0;
+    const clock_t start = clock();
+
+    for (i = 0;  i < passes;  i++)
+    {
+        for (keysym = 0;  keysym <= 0xffff;  keysym++)
+            sink += convert(keysym);
+    }
+
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(void)
+{
+    const int passes = 200;
+    double table, search;
+    unsigned long mismatches = 0;
+
+    mismatches += compareRange(0x00000000, 0x0001ffff);
+    mismatches += compareRange(0x00fff000, 0x0110ffff);
+    mismatches += compareRange(0xfffe0000, 0xffffffff);
+
+    if (mismatches)
+    {
+        printf("%lu keysyms converted differently\n", mismatches);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("All keysyms converted identically\n");
+
+    // Build the table before timing it
+    _glfwKeySym2Unicode(0x1000);
+
+    table = timeSweep(_glfwKeySym2Unicode, passes);
+    search = timeSweep(referenceKeySym2Unicode, passes);
+
+    printf("Table:  %.2f ns per keysym\n", table * 1e9 / (passes * 65536.0));
+    printf("Search: %.2f ns per keysym\n", search * 1e9 / (passes * 65536.0));
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,303 @@
+//========================================================================
+// Pixel conversion test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test compares the cursor and icon pixel conversions, both the SSE2 or
+// NEON path selected at compile time and the scalar path, with the per-pixel
+// code the backends used before, for every color and alpha value and at
+// every alignment of the vector loops, and then times both over a large set
+// of icon images
+//
+// The conversion is internal to GLFW, so its source is compiled into the test
+//
+//========================================================================
+
+#include "pixel.c"
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// One pixel for every pair of color and alpha values
+#define PIXEL_COUNT (256 * 256)
+
+// Converts RGBA pixels to ARGB as the X11 window icon code used to
+//
+static void referenceConvertToARGB(long* target,
+                                   const unsigned char* source,
+                                   size_t count)
+{
+    size_t j;
+
+    for (j = 0;  j < count;  j++)
+    {
+        *target++ = (source[j * 4 + 0] << 16) |
+                    (source[j * 4 + 1] <<  8) |
+                    (source[j * 4 + 2] <<  0) |
+                    (source[j * 4 + 3] << 24);
+    }
+}
+
+// Converts RGBA pixels to premultiplied ARGB as the X11 cursor code used to
+//
+static void referenceConvertToPremultipliedARGB(uint32_t* target,
+                                                const unsigned char* source,
+                                                size_t count)
+{
+    size_t i;
+
+    for (i = 0;  i < count;  i++, target++, source += 4)
+    {
+        unsigned int alpha = source[3];
+
+        *target = (alpha << 24) |
+                  ((unsigned char) ((source[0] * alpha) / 255) << 16) |
+                  ((unsigned char) ((source[1] * alpha) / 255) <<  8) |
+                  ((unsigned char) ((source[2] * alpha) / 255) <<  0);
+    }
+}
+
+// Returns the number of pixels in the specified range that differ from the
+// reference and prints the first few of them
+//
+static unsigned long compareRange(const char* name,
+                                  const uint32_t* expected,
+                                  const uint32_t* actual,
+                                  size_t first,
+                                  size_t count)
+{
+    size_t i;
+    unsigned long mismatches = 0;
+
+    for (i = 0;  i < count;  i++)
+    {
+        if (expected[first + i] == actual[i])
+            continue;
+
+        if (mismatches < 10)
+        {
+            printf("%s: pixel %lu: expected 0x%08x, got 0x%08x\n",
+                   name, (unsigned long) (first + i),
+                   (unsigned int) expected[first + i],
+                   (unsigned int) actual[i]);
+        }
+
+        mismatches++;
+    }
+
+    return mismatches;
+}
+
+// Compares each conversion with the reference over the specified range of
+// pixels, which need not be aligned for the vector loops
+//
+static unsigned long compareConversions(const unsigned char* source,
+                                        const uint32_t* plain,
+                                        const uint32_t* premultiplied,
+                                        size_t first,
+                                        size_t count)
+{
+    size_t i;
+    unsigned long mismatches = 0;
+    uint32_t* target = calloc(count + 1, sizeof(uint32_t));
+    long* longs = calloc(count + 1, sizeof(long));
+
+    source += first * 4;
+
+    _glfwConvertToARGB(target, source, count);
+    mismatches += compareRange("ARGB", plain, target, first, count);
+
+    convertToARGB(target, source, count);
+    mismatches += compareRange("Scalar ARGB", plain, target, first, count);
+
+    _glfwConvertToPremultipliedARGB(target, source, count);
+    mismatches += compareRange("Premultiplied ARGB",
+                               premultiplied, target, first, count);
+
+    convertToPremultipliedARGB(target, source, count);
+    mismatches += compareRange("Scalar premultiplied ARGB",
+                               premultiplied, target, first, count);
+
+    _glfwConvertToARGBLong(longs, source, count);
+    for (i = 0;  i < count;  i++)
+        target[i] = (uint32_t) longs[i];
+
+    mismatches += compareRange("ARGB long", plain, target, first, count);
+
+    free(target);
+    free(longs);
+    return mismatches;
+}
+
+// Returns the time taken to convert the specified pixels the specified
+// number of times
+//
+static double timeConversion(void (*convert)(uint32_t*, const unsigned char*, size_t),
+                             uint32_t* target,
+                             const unsigned char* source,
+                             size_t count,
+                             int passes)
+{
+    int i;
+    const clock_t start = clock();
+
+    for (i = 0;  i < passes;  i++)
+        convert(target, source, count);
+
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+// Returns the time taken to convert the specified pixels to longs the
+// specified number of times
+//
+static double timeLongConversion(void (*convert)(long*, const unsigned char*, size_t),
+                                 long* target,
+                                 const unsigned char* source,
+                                 size_t count,
+                                 int passes)
+{
+    int i;
+    const clock_t start = clock();
+
+    for (i = 0;  i < passes;  i++)
+        convert(target, source, count);
+
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(void)
+{
+    // A window icon set with every common size
+    const int sizes[] = { 16, 20, 24, 32, 40, 48, 64, 96, 128, 256, 512 };
+    const int passes = 200;
+    int i;
+    size_t first, count, total = 0;
+    unsigned long mismatches = 0;
+    unsigned char* source;
+    uint32_t* plain;
+    uint32_t* premultiplied;
+    uint32_t* target;
+    long* longs;
+    long* referenceLongs;
+    double reference, converted;
+
+#if defined(_GLFW_PIXEL_SSE2)
+    printf("Testing the SSE2 and scalar paths\n");
+#elif defined(_GLFW_PIXEL_NEON)
+    printf("Testing the NEON and scalar paths\n");
+#else
+    printf("Testing the scalar path\n");
+#endif
+
+    // Every channel takes every value with every alpha value
+    source = calloc(PIXEL_COUNT, 4);
+    for (i = 0;  i < PIXEL_COUNT;  i++)
+    {
+        const int color = i & 0xff;
+
+        source[i * 4 + 0] = (unsigned char) color;
+        source[i * 4 + 1] = (unsigned char) (color + 85);
+        source[i * 4 + 2] = (unsigned char) (color + 170);
+        source[i * 4 + 3] = (unsigned char) (i >> 8);
+    }
+
+    plain = calloc(PIXEL_COUNT, sizeof(uint32_t));
+    premultiplied = calloc(PIXEL_COUNT, sizeof(uint32_t));
+    referenceLongs = calloc(PIXEL_COUNT, sizeof(long));
+
+    referenceConvertToARGB(referenceLongs, source, PIXEL_COUNT);
+    for (i = 0;  i < PIXEL_COUNT;  i++)
+        plain[i] = (uint32_t) referenceLongs[i];
+
+    referenceConvertToPremultipliedARGB(premultiplied, source, PIXEL_COUNT);
+
+    mismatches += compareConversions(source, plain, premultiplied,
+                                     0, PIXEL_COUNT);
+
+    // The vector loops leave a scalar tail, so every start and length up to
+    // a few vectors is checked
+    for (first = 0;  first < 32;  first++)
+    {
+        for (count = 0;  count < 64;  count++)
+        {
+            mismatches += compareConversions(source, plain, premultiplied,
+                                             first * 257, count);
+        }
+    }
+
+    if (mismatches)
+    {
+        printf("%lu pixels converted differently\n", mismatches);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("All pixels converted identically\n");
+
+    for (i = 0;  i < (int) (sizeof(sizes) / sizeof(sizes[0]));  i++)
+        total += (size_t) sizes[i] * sizes[i];
+
+    // The pixels of the whole icon set are converted in one call, as the X11
+    // window icon code does
+    free(source);
+    source = calloc(total, 4);
+    for (count = 0;  count < total * 4;  count++)
+        source[count] = (unsigned char) (rand() & 0xff);
+
+    target = calloc(total, sizeof(uint32_t));
+    longs = calloc(total, sizeof(long));
+    free(referenceLongs);
+    referenceLongs = calloc(total, sizeof(long));
+
+    printf("Converting %lu pixels of %i icon images %i times\n",
+           (unsigned long) total, (int) (sizeof(sizes) / sizeof(sizes[0])),
+           passes);
+
+    reference = timeLongConversion(referenceConvertToARGB,
+                                   referenceLongs, source, total, passes);
+    converted = timeLongConversion(_glfwConvertToARGBLong,
+                                   longs, source, total, passes);
+
+    printf("ARGB long:          %.2f ns per pixel (reference %.2f ns)\n",
+           converted * 1e9 / ((double) passes * total),
+           reference * 1e9 / ((double) passes * total));
+
+    reference = timeConversion(referenceConvertToPremultipliedARGB,
+                               target, source, total, passes);
+    converted = timeConversion(_glfwConvertToPremultipliedARGB,
+                               target, source, total, passes);
+
+    printf("Premultiplied ARGB: %.2f ns per pixel (reference %.2f ns)\n",
+           converted * 1e9 / ((double) passes * total),
+           reference * 1e9 / ((double) passes * total));
+
+    free(source);
+    free(plain);
+    free(premultiplied);
+    free(target);
+    free(longs);
+    free(referenceLongs);
+
+    exit(EXIT_SUCCESS);
+}